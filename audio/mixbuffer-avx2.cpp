@@ -0,0 +1,88 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "audio/mixbuffer.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Audio {
+
+void MixBuffer::mixStereoAVX2(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	const __m256i vol = _mm256_set_epi32(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		__m256i in = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)src));
+		__m256i out = _mm256_srai_epi32(_mm256_mullo_epi32(in, vol), 8);
+		_mm256_storeu_si256((__m256i *)dst, _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)dst), out));
+		src += 8;
+		dst += 8;
+	}
+
+	mixStereoGeneric(dst, src, numFrames, volL, volR);
+}
+
+void MixBuffer::mixMonoAVX2(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	const __m256i vol = _mm256_set1_epi32((volR << 16) | volL);
+
+	for (; numFrames >= 8; numFrames -= 8) {
+		__m256i in = _mm256_loadu_si256((const __m256i *)src);
+		__m256i out = _mm256_srai_epi32(_mm256_madd_epi16(in, vol), 9);
+		_mm256_storeu_si256((__m256i *)dst, _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)dst), out));
+		src += 16;
+		dst += 8;
+	}
+
+	mixMonoGeneric(dst, src, numFrames, volL, volR);
+}
+
+void MixBuffer::saturateAVX2(st_sample_t *dst, const int32 *src, uint numSamples) {
+	for (; numSamples >= 16; numSamples -= 16) {
+		__m256i lo = _mm256_loadu_si256((const __m256i *)src);
+		__m256i hi = _mm256_loadu_si256((const __m256i *)(src + 8));
+		// packs works on 128-bit lanes, so the quadwords need to be reordered
+		__m256i out = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = _mm256_xor_si256(out, _mm256_set1_epi16((short)0x8000));
+#endif
+		_mm256_storeu_si256((__m256i *)dst, out);
+		src += 16;
+		dst += 16;
+	}
+
+	saturateGeneric(dst, src, numSamples);
+}
+
+} // End of namespace Audio
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,100 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "audio/mixbuffer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Audio {
+
+void MixBuffer::mixStereoSSE2(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	// Every 32-bit lane holds a sample in its low half and zero in its
+	// high half, so madd yields the sign correct 32-bit products.
+	const __m128i vol = _mm_set_epi32(volR, volL, volR, volL);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		__m128i in = _mm_loadu_si128((const __m128i *)src);
+		__m128i lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(in, zero), vol), 8);
+		__m128i hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(in, zero), vol), 8);
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi32(_mm_loadu_si128((const __m128i *)dst), lo));
+		_mm_storeu_si128((__m128i *)(dst + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(dst + 4)), hi));
+		src += 8;
+		dst += 8;
+	}
+
+	mixStereoGeneric(dst, src, numFrames, volL, volR);
+}
+
+void MixBuffer::mixMonoSSE2(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	const __m128i vol = _mm_set1_epi32((volR << 16) | volL);
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		__m128i in = _mm_loadu_si128((const __m128i *)src);
+		__m128i out = _mm_srai_epi32(_mm_madd_epi16(in, vol), 9);
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi32(_mm_loadu_si128((const __m128i *)dst), out));
+		src += 8;
+		dst += 4;
+	}
+
+	mixMonoGeneric(dst, src, numFrames, volL, volR);
+}
+
+void MixBuffer::saturateSSE2(st_sample_t *dst, const int32 *src, uint numSamples) {
+	for (; numSamples >= 8; numSamples -= 8) {
+		__m128i lo = _mm_loadu_si128((const __m128i *)src);
+		__m128i hi = _mm_loadu_si128((const __m128i *)(src + 4));
+		__m128i out = _mm_packs_epi32(lo, hi);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = _mm_xor_si128(out, _mm_set1_epi16((short)0x8000));
+#endif
+		_mm_storeu_si128((__m128i *)dst, out);
+		src += 8;
+		dst += 8;
+	}
+
+	saturateGeneric(dst, src, numSamples);
+}
+
+} // End of namespace Audio
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
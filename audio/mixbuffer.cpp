@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/mixbuffer.h"
+#include "common/system.h"
+#include "common/util.h"
+
+namespace Audio {
+
+MixBuffer::MixFunc MixBuffer::mixStereoFunc = nullptr;
+MixBuffer::MixFunc MixBuffer::mixMonoFunc = nullptr;
+MixBuffer::SaturateFunc MixBuffer::saturateFunc = nullptr;
+
+void MixBuffer::init() {
+	mixStereoFunc = mixStereoGeneric;
+	mixMonoFunc = mixMonoGeneric;
+	saturateFunc = saturateGeneric;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		mixStereoFunc = mixStereoSSE2;
+		mixMonoFunc = mixMonoSSE2;
+		saturateFunc = saturateSSE2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		mixStereoFunc = mixStereoAVX2;
+		mixMonoFunc = mixMonoAVX2;
+		saturateFunc = saturateAVX2;
+	}
+#endif
+}
+
+void MixBuffer::mixStereo(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	if (!mixStereoFunc)
+		init();
+	mixStereoFunc(dst, src, numFrames, volL, volR);
+}
+
+void MixBuffer::mixMono(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	if (!mixMonoFunc)
+		init();
+	mixMonoFunc(dst, src, numFrames, volL, volR);
+}
+
+void MixBuffer::saturate(st_sample_t *dst, const int32 *src, uint numSamples) {
+	if (!saturateFunc)
+		init();
+	saturateFunc(dst, src, numSamples);
+}
+
+// The SIMD variants only implement the bulk of the work and rely on the
+// generic versions below for the remaining samples, so these define the
+// exact results every variant has to produce. As kMaxMixerVolume is 256,
+// the volume scaling is a plain arithmetic shift.
+
+void MixBuffer::mixStereoGeneric(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	while (numFrames--) {
+		dst[0] += (src[0] * (int)volL) >> 8;
+		dst[1] += (src[1] * (int)volR) >> 8;
+		dst += 2;
+		src += 2;
+	}
+}
+
+void MixBuffer::mixMonoGeneric(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	while (numFrames--) {
+		*dst++ += (src[0] * (int)volL + src[1] * (int)volR) >> 9;
+		src += 2;
+	}
+}
+
+void MixBuffer::saturateGeneric(st_sample_t *dst, const int32 *src, uint numSamples) {
+	while (numSamples--) {
+		int32 val = CLIP<int32>(*src++, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		*dst++ = ((st_sample_t)val) ^ 0x8000;
+#else
+		*dst++ = (st_sample_t)val;
+#endif
+	}
+}
+
+} // End of namespace Audio
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_MIXBUFFER_H
+#define AUDIO_MIXBUFFER_H
+
+#include "common/scummsys.h"
+#include "audio/rate.h"
+
+class DeferredMixerTestSuite;
+class MixBufferTestSuite;
+
+namespace Audio {
+
+/**
+ * @defgroup audio_mixbuffer Mix buffer
+ * @ingroup audio
+ *
+ * @brief Kernels for mixing into the 32-bit intermediate mixing bus.
+ * @{
+ */
+
+/**
+ * The mixer accumulates all channels into a 32-bit buffer and only
+ * saturates to 16-bit once all channels have been mixed. The functions
+ * below implement these steps and are dispatched at runtime to a SIMD
+ * variant if the CPU supports one.
+ *
+ * Input frames are always interleaved stereo pairs; mono streams are
+ * expanded by the rate converter. Volumes are in the range
+ * 0 - Mixer::kMaxMixerVolume.
+ */
+class MixBuffer {
+public:
+	/**
+	 * Scales stereo frames by the given volumes and adds them to a stereo
+	 * mixing buffer.
+	 */
+	static void mixStereo(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR);
+
+	/**
+	 * Scales stereo frames by the given volumes, downmixes them and adds
+	 * them to a mono mixing buffer.
+	 */
+	static void mixMono(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR);
+
+	/**
+	 * Clamps the mixing buffer to the 16-bit output range.
+	 */
+	static void saturate(st_sample_t *dst, const int32 *src, uint numSamples);
+
+private:
+	typedef void(*MixFunc)(int32 *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+	typedef void(*SaturateFunc)(st_sample_t *, const int32 *, uint);
+
+	static MixFunc mixStereoFunc;
+	static MixFunc mixMonoFunc;
+	static SaturateFunc saturateFunc;
+
+	static void init();
+
+	static void mixStereoGeneric(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR);
+	static void mixMonoGeneric(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR);
+	static void saturateGeneric(st_sample_t *dst, const int32 *src, uint numSamples);
+#ifdef SCUMMVM_SSE2
+	static void mixStereoSSE2(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR);
+	static void mixMonoSSE2(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR);
+	static void saturateSSE2(st_sample_t *dst, const int32 *src, uint numSamples);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void mixStereoAVX2(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR);
+	static void mixMonoAVX2(int32 *dst, const st_sample_t *src, uint numFrames, st_volume_t volL, st_volume_t volR);
+	static void saturateAVX2(st_sample_t *dst, const int32 *src, uint numSamples);
+#endif
+
+	friend class ::DeferredMixerTestSuite;
+	friend class ::MixBufferTestSuite;
+};
+
+/** @} */
+} // End of namespace Audio
+
+#endif
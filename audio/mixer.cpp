@@ -25,6 +25,7 @@
 #include "common/textconsole.h"
 
 #include "audio/mixer_intern.h"
+#include "audio/mixbuffer.h"
 #include "audio/rate.h"
 #include "audio/audiostream.h"
 #include "audio/timestamp.h"
@@ -42,19 +43,18 @@ namespace Audio {
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality);
 	~Channel();
 
 	/**
 	 * Mixes the channel's samples into the given buffer.
 	 *
-	 * @param data buffer where to mix the data
+	 * @param data 32-bit mixing buffer where to mix the data
 	 * @param len  number of sample *pairs*. So a value of
-	 *             10 means that the buffer contains twice 10 sample, each
-	 *             16 bits, for a total of 40 bytes.
+	 *             10 means that the buffer contains twice 10 samples.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int32 *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -86,6 +86,11 @@ public:
 	 */
 	bool isPaused() const { return (_pauseLevel != 0); }
 
+	/**
+	 * Queries how many times the channel has been paused.
+	 */
+	int getPauseLevel() const { return _pauseLevel; }
+
 	/**
 	 * Sets the channel's own volume.
 	 *
@@ -98,7 +103,7 @@ public:
 	 *
 	 * @return volume
 	 */
-	byte getVolume();
+	byte getVolume() const;
 
 	/**
 	 * Sets the channel's balance setting.
@@ -112,7 +117,7 @@ public:
 	 *
 	 * @return balance
 	 */
-	int8 getBalance();
+	int8 getBalance() const;
 
 	/**
 	 * Sets the channel's left fader level.
@@ -126,7 +131,7 @@ public:
 	 *
 	 * @return The channel's left fader level.
 	 */
-	uint8 getFaderL();
+	uint8 getFaderL() const;
 
 	/**
 	 * Sets the channel's right fader level.
@@ -140,7 +145,7 @@ public:
 	 *
 	 * @return The channel's right fader level.
 	 */
-	uint8 getFaderR();
+	uint8 getFaderR() const;
 
 	/**
 	 * Set the channel's sample rate.
@@ -154,7 +159,7 @@ public:
 	 *
 	 * @return The current sample rate of the channel.
 	 */
-	uint32 getRate();
+	uint32 getRate() const;
 
 	/**
 	 * Reset the sample rate of the channel back to its
@@ -162,6 +167,11 @@ public:
 	 */
 	void resetRate();
 
+	/**
+	 * Get the native sample rate of the channel's AudioStream.
+	 */
+	uint32 getStreamRate() const { return _stream->getRate(); }
+
 	/**
 	 * Notifies the channel that the global sound type
 	 * volume settings changed.
@@ -227,17 +237,24 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _rateConverterQuality(kRateConverterLinear), _soundTypeSettings(),
+	  _deferredCommands(false), _commandMutex(), _commandHead(0), _commandCount(0),
+	  _mixBuffer(nullptr), _mixBufferSize(0) {
 
 	assert(sampleRate > 0);
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = nullptr;
+
+	_mixBufferSize = (outBufSize ? outBufSize : (uint)DEFAULT_MIX_BUFFER_FRAMES) * (stereo ? 2 : 1);
+	_mixBuffer = new int32[_mixBufferSize];
 }
 
 MixerImpl::~MixerImpl() {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	delete[] _mixBuffer;
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -246,6 +263,23 @@ void MixerImpl::setReady(bool ready) {
 	_mixerReady = ready;
 }
 
+void MixerImpl::setRateConverterQuality(RateConverterQuality quality) {
+	Common::StackLock lock(_mutex);
+
+	_rateConverterQuality = quality;
+}
+
+void MixerImpl::setDeferredCommands(bool enable) {
+	Common::StackLock lock(_mutex);
+
+	applyPendingCommands();
+
+	Common::StackLock commandLock(_commandMutex);
+	_deferredCommands = enable;
+	for (int i = 0; i != NUM_CHANNELS; i++)
+		updateChannelState(i);
+}
+
 uint MixerImpl::getOutputRate() const {
 	return _sampleRate;
 }
@@ -281,6 +315,206 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	_handleSeed++;
 	if (handle)
 		*handle = chanHandle;
+
+	if (_deferredCommands) {
+		Common::StackLock commandLock(_commandMutex);
+		updateChannelState(index);
+	}
+}
+
+void MixerImpl::deleteChannel(int index) {
+	delete _channels[index];
+	_channels[index] = nullptr;
+
+	if (_deferredCommands) {
+		Common::StackLock commandLock(_commandMutex);
+		_channelStates[index].active = false;
+	}
+}
+
+void MixerImpl::updateChannelState(int index) {
+	ChannelState &state = _channelStates[index];
+	const Channel *chan = _channels[index];
+
+	if (!chan) {
+		state.active = false;
+		return;
+	}
+
+	state.active = true;
+	state.handle = chan->getHandle()._val;
+	state.id = chan->getId();
+	state.type = chan->getType();
+	state.volume = chan->getVolume();
+	state.balance = chan->getBalance();
+	state.faderL = chan->getFaderL();
+	state.faderR = chan->getFaderR();
+	state.rate = chan->getRate();
+	state.nativeRate = chan->getStreamRate();
+	state.pauseLevel = chan->getPauseLevel();
+}
+
+bool MixerImpl::findChannelState(SoundHandle handle, ChannelState &state) const {
+	Common::StackLock commandLock(_commandMutex);
+
+	const ChannelState &channelState = _channelStates[handle._val % NUM_CHANNELS];
+	if (!channelState.active || channelState.handle != handle._val)
+		return false;
+
+	state = channelState;
+	return true;
+}
+
+bool MixerImpl::postCommand(CommandType type, uint32 handle, int id, uint32 value) {
+	if (!_deferredCommands)
+		return false;
+
+	while (true) {
+		{
+			Common::StackLock commandLock(_commandMutex);
+
+			if (_commandCount < COMMAND_QUEUE_SIZE) {
+				// Update the engine side view right away, so that queries
+				// issued before the next mixer run already see the change.
+				ChannelState *state = &_channelStates[handle % NUM_CHANNELS];
+				if (!state->active || state->handle != handle)
+					state = nullptr;
+
+				switch (type) {
+				case kCommandPauseAll:
+					for (int i = 0; i != NUM_CHANNELS; i++) {
+						if (!_channelStates[i].active)
+							continue;
+						if (value)
+							_channelStates[i].pauseLevel++;
+						else if (_channelStates[i].pauseLevel > 0)
+							_channelStates[i].pauseLevel--;
+					}
+					break;
+				case kCommandPauseHandle:
+					if (!state)
+						return true;
+					if (value)
+						state->pauseLevel++;
+					else if (state->pauseLevel > 0)
+						state->pauseLevel--;
+					break;
+				case kCommandSetVolume:
+					if (!state)
+						return true;
+					state->volume = (byte)value;
+					break;
+				case kCommandSetBalance:
+					if (!state)
+						return true;
+					state->balance = (int8)value;
+					break;
+				case kCommandSetFaderL:
+					if (!state)
+						return true;
+					state->faderL = (uint8)value;
+					break;
+				case kCommandSetFaderR:
+					if (!state)
+						return true;
+					state->faderR = (uint8)value;
+					break;
+				case kCommandSetRate:
+					if (!state)
+						return true;
+					state->rate = value;
+					break;
+				case kCommandResetRate:
+					if (!state)
+						return true;
+					state->rate = state->nativeRate;
+					break;
+				case kCommandLoop:
+					if (!state)
+						return true;
+					break;
+				default:
+					break;
+				}
+
+				Command &cmd = _commands[(_commandHead + _commandCount) % COMMAND_QUEUE_SIZE];
+				cmd.type = type;
+				cmd.handle = handle;
+				cmd.id = id;
+				cmd.value = value;
+				_commandCount++;
+				return true;
+			}
+		}
+
+		// The queue is full, so we have to wait for the mixer after all
+		Common::StackLock lock(_mutex);
+		applyPendingCommands();
+	}
+}
+
+void MixerImpl::applyPendingCommands() {
+	Command commands[COMMAND_QUEUE_SIZE];
+	uint count;
+
+	{
+		Common::StackLock commandLock(_commandMutex);
+
+		count = _commandCount;
+		for (uint i = 0; i < count; i++)
+			commands[i] = _commands[(_commandHead + i) % COMMAND_QUEUE_SIZE];
+
+		_commandHead = 0;
+		_commandCount = 0;
+	}
+
+	for (uint i = 0; i < count; i++)
+		applyCommand(commands[i]);
+}
+
+void MixerImpl::applyCommand(const Command &cmd) {
+	if (cmd.type == kCommandPauseAll) {
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i])
+				_channels[i]->pause(cmd.value != 0);
+		}
+		return;
+	}
+
+	// Ignore commands for sounds that terminated in the meantime
+	const int index = cmd.handle % NUM_CHANNELS;
+	Channel *chan = _channels[index];
+	if (!chan || chan->getHandle()._val != cmd.handle)
+		return;
+
+	switch (cmd.type) {
+	case kCommandPauseHandle:
+		chan->pause(cmd.value != 0);
+		break;
+	case kCommandSetVolume:
+		chan->setVolume((byte)cmd.value);
+		break;
+	case kCommandSetBalance:
+		chan->setBalance((int8)cmd.value);
+		break;
+	case kCommandSetFaderL:
+		chan->setFaderL((uint8)cmd.value);
+		break;
+	case kCommandSetFaderR:
+		chan->setFaderR((uint8)cmd.value);
+		break;
+	case kCommandSetRate:
+		chan->setRate(cmd.value);
+		break;
+	case kCommandResetRate:
+		chan->resetRate();
+		break;
+	case kCommandLoop:
+		chan->loop();
+		break;
+	default:
+		break;
+	}
 }
 
 void MixerImpl::playStream(
@@ -301,6 +535,9 @@ void MixerImpl::playStream(
 
 	assert(_mixerReady);
 
+	// Stop requests still pending must not block the new sound
+	applyPendingCommands();
+
 	// Prevent duplicate sounds
 	if (id != -1) {
 		for (int i = 0; i != NUM_CHANNELS; i++)
@@ -322,7 +559,7 @@ void MixerImpl::playStream(
 #endif
 
 	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent, _rateConverterQuality);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
 	insertChannel(handle, chan);
@@ -331,73 +568,116 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
-	Common::StackLock lock(_mutex);
-
 	int16 *buf = (int16 *)samples;
 
-	// Since the mixer callback has been called, the mixer must be ready...
-	_mixerReady = true;
+	// Only the channels playing now are mixed by this call. Sounds started
+	// while it runs wait for the next one, so that sounds started together
+	// also start playing together.
+	bool playing[NUM_CHANNELS];
+	uint32 handles[NUM_CHANNELS];
 
-	//  zero the buf
-	memset(buf, 0, len);
+	{
+		Common::StackLock lock(_mutex);
+
+		// Since the mixer callback has been called, the mixer must be ready...
+		_mixerReady = true;
+
+		applyPendingCommands();
+
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			playing[i] = _channels[i] != nullptr;
+			handles[i] = playing[i] ? _channels[i]->getHandle()._val : 0;
+		}
+	}
 
 	// we store 16-bit samples
-	if (_stereo) {
+	uint numSamples = len >> 1;
+	if (_stereo)
 		assert(len % 4 == 0);
-		len >>= 2;
-	} else {
+	else
 		assert(len % 2 == 0);
-		len >>= 1;
-	}
 
-	// mix all channels
-	int res = 0, tmp;
+	// The channels are mixed into a 32-bit buffer, which is only clamped
+	// to the output range once all of them have been added up. Requests
+	// larger than that buffer are handled a piece at a time.
+	int mixed[NUM_CHANNELS];
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i]) {
+		mixed[i] = 0;
+
+	while (numSamples > 0) {
+		const uint chunkSamples = MIN(numSamples, _mixBufferSize);
+		const uint chunkFrames = _stereo ? chunkSamples >> 1 : chunkSamples;
+
+		//  zero the buf
+		memset(_mixBuffer, 0, chunkSamples * sizeof(int32));
+
+		// mix all channels. The mutex is only held for one channel at a
+		// time, so that engine calls don't wait for the whole mix.
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (!playing[i])
+				continue;
+
+			Common::StackLock lock(_mutex);
+
+			// The channel may have been stopped in the meantime
+			if (!_channels[i] || _channels[i]->getHandle()._val != handles[i]) {
+				playing[i] = false;
+				continue;
+			}
+
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = nullptr;
+				deleteChannel(i);
+				playing[i] = false;
 			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
-
-				if (tmp > res)
-					res = tmp;
+				mixed[i] += _channels[i]->mix(_mixBuffer, chunkFrames);
 			}
 		}
 
+		MixBuffer::saturate(buf, _mixBuffer, chunkSamples);
+
+		buf += chunkSamples;
+		numSamples -= chunkSamples;
+	}
+
+	int res = 0;
+	for (int i = 0; i != NUM_CHANNELS; i++)
+		if (mixed[i] > res)
+			res = mixed[i];
+
 	return res;
 }
 
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
+	applyPendingCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = nullptr;
-		}
+		if (_channels[i] != nullptr && !_channels[i]->isPermanent())
+			deleteChannel(i);
 	}
 }
 
 void MixerImpl::stopID(int id) {
+	// Stopping is never deferred: callers may free the stream data right
+	// after this returns, so the mixer must be done with the channel.
 	Common::StackLock lock(_mutex);
+	applyPendingCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = nullptr;
-		}
+		if (_channels[i] != nullptr && _channels[i]->getId() == id)
+			deleteChannel(i);
 	}
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
+	// Not deferred either, see stopID()
 	Common::StackLock lock(_mutex);
+	applyPendingCommands();
 
 	// Simply ignore stop requests for handles of sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return;
 
-	delete _channels[index];
-	_channels[index] = nullptr;
+	deleteChannel(index);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
@@ -416,6 +696,9 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
+	if (postCommand(kCommandSetVolume, handle._val, 0, volume))
+		return;
+
 	Common::StackLock lock(_mutex);
 
 	const int index = handle._val % NUM_CHANNELS;
@@ -426,6 +709,11 @@ void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
+	if (_deferredCommands) {
+		ChannelState state;
+		return findChannelState(handle, state) ? state.volume : 0;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -434,6 +722,9 @@ byte MixerImpl::getChannelVolume(SoundHandle handle) {
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
+	if (postCommand(kCommandSetBalance, handle._val, 0, (uint8)balance))
+		return;
+
 	Common::StackLock lock(_mutex);
 
 	const int index = handle._val % NUM_CHANNELS;
@@ -444,6 +735,11 @@ void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
+	if (_deferredCommands) {
+		ChannelState state;
+		return findChannelState(handle, state) ? state.balance : 0;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -452,6 +748,9 @@ int8 MixerImpl::getChannelBalance(SoundHandle handle) {
 }
 
 void MixerImpl::setChannelFaderL(SoundHandle handle, uint8 faderL) {
+	if (postCommand(kCommandSetFaderL, handle._val, 0, faderL))
+		return;
+
 	Common::StackLock lock(_mutex);
 
 	const int index = handle._val % NUM_CHANNELS;
@@ -462,6 +761,11 @@ void MixerImpl::setChannelFaderL(SoundHandle handle, uint8 faderL) {
 }
 
 uint8 MixerImpl::getChannelFaderL(SoundHandle handle) {
+	if (_deferredCommands) {
+		ChannelState state;
+		return findChannelState(handle, state) ? state.faderL : 0;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -470,6 +774,9 @@ uint8 MixerImpl::getChannelFaderL(SoundHandle handle) {
 }
 
 void MixerImpl::setChannelFaderR(SoundHandle handle, uint8 faderR) {
+	if (postCommand(kCommandSetFaderR, handle._val, 0, faderR))
+		return;
+
 	Common::StackLock lock(_mutex);
 
 	const int index = handle._val % NUM_CHANNELS;
@@ -480,6 +787,11 @@ void MixerImpl::setChannelFaderR(SoundHandle handle, uint8 faderR) {
 }
 
 uint8 MixerImpl::getChannelFaderR(SoundHandle handle) {
+	if (_deferredCommands) {
+		ChannelState state;
+		return findChannelState(handle, state) ? state.faderR : 0;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -488,6 +800,9 @@ uint8 MixerImpl::getChannelFaderR(SoundHandle handle) {
 }
 
 void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
+	if (postCommand(kCommandSetRate, handle._val, 0, rate))
+		return;
+
 	Common::StackLock lock(_mutex);
 
 	const int index = handle._val % NUM_CHANNELS;
@@ -498,6 +813,11 @@ void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
 }
 
 uint32 MixerImpl::getChannelRate(SoundHandle handle) {
+	if (_deferredCommands) {
+		ChannelState state;
+		return findChannelState(handle, state) ? state.rate : 0;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -506,6 +826,9 @@ uint32 MixerImpl::getChannelRate(SoundHandle handle) {
 }
 
 void MixerImpl::resetChannelRate(SoundHandle handle) {
+	if (postCommand(kCommandResetRate, handle._val, 0, 0))
+		return;
+
 	Common::StackLock lock(_mutex);
 
 	const int index = handle._val % NUM_CHANNELS;
@@ -521,6 +844,7 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	applyPendingCommands();
 
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
@@ -530,6 +854,9 @@ Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 }
 
 void MixerImpl::loopChannel(SoundHandle handle) {
+	if (postCommand(kCommandLoop, handle._val, 0, 0))
+		return;
+
 	Common::StackLock lock(_mutex);
 
 	const int index = handle._val % NUM_CHANNELS;
@@ -540,6 +867,9 @@ void MixerImpl::loopChannel(SoundHandle handle) {
 }
 
 void MixerImpl::pauseAll(bool paused) {
+	if (postCommand(kCommandPauseAll, 0, 0, paused))
+		return;
+
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr) {
@@ -549,6 +879,26 @@ void MixerImpl::pauseAll(bool paused) {
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
+	if (_deferredCommands) {
+		uint32 handle = 0;
+		bool found = false;
+		{
+			Common::StackLock commandLock(_commandMutex);
+			for (int i = 0; i != NUM_CHANNELS; i++) {
+				const ChannelState &state = _channelStates[i];
+				if (state.active && state.id == id) {
+					handle = state.handle;
+					found = true;
+					break;
+				}
+			}
+		}
+
+		if (found)
+			postCommand(kCommandPauseHandle, handle, 0, paused);
+		return;
+	}
+
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
@@ -559,6 +909,9 @@ void MixerImpl::pauseID(int id, bool paused) {
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
+	if (postCommand(kCommandPauseHandle, handle._val, 0, paused))
+		return;
+
 	Common::StackLock lock(_mutex);
 
 	// Simply ignore (un)pause requests for sounds that already terminated
@@ -570,6 +923,18 @@ void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
+	if (_deferredCommands) {
+#ifdef ENABLE_EVENTRECORDER
+		g_eventRec.updateSubsystems();
+#endif
+
+		Common::StackLock commandLock(_commandMutex);
+		for (int i = 0; i != NUM_CHANNELS; i++)
+			if (_channelStates[i].active && _channelStates[i].id == id)
+				return true;
+		return false;
+	}
+
 	Common::StackLock lock(_mutex);
 
 #ifdef ENABLE_EVENTRECORDER
@@ -583,6 +948,11 @@ bool MixerImpl::isSoundIDActive(int id) {
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
+	if (_deferredCommands) {
+		ChannelState state;
+		return findChannelState(handle, state) ? state.id : 0;
+	}
+
 	Common::StackLock lock(_mutex);
 	const int index = handle._val % NUM_CHANNELS;
 	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
@@ -591,6 +961,15 @@ int MixerImpl::getSoundID(SoundHandle handle) {
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
+	if (_deferredCommands) {
+#ifdef ENABLE_EVENTRECORDER
+		g_eventRec.updateSubsystems();
+#endif
+
+		ChannelState state;
+		return findChannelState(handle, state);
+	}
+
 	Common::StackLock lock(_mutex);
 
 #ifdef ENABLE_EVENTRECORDER
@@ -602,6 +981,14 @@ bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
+	if (_deferredCommands) {
+		Common::StackLock commandLock(_commandMutex);
+		for (int i = 0; i != NUM_CHANNELS; i++)
+			if (_channelStates[i].active && _channelStates[i].type == type)
+				return true;
+		return false;
+	}
+
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i] && _channels[i]->getType() == type)
@@ -639,7 +1026,7 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 #pragma mark -
 
 Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
+				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality)
 	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
 	  _balance(0), _faderL(255), _faderR(255), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
 	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0),
@@ -648,7 +1035,7 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -660,7 +1047,7 @@ void Channel::setVolume(const byte volume) {
 	updateChannelVolumes();
 }
 
-byte Channel::getVolume() {
+byte Channel::getVolume() const {
 	return _volume;
 }
 
@@ -669,7 +1056,7 @@ void Channel::setBalance(const int8 balance) {
 	updateChannelVolumes();
 }
 
-int8 Channel::getBalance() {
+int8 Channel::getBalance() const {
 	return _balance;
 }
 
@@ -678,7 +1065,7 @@ void Channel::setFaderL(uint8 faderL) {
 	updateChannelVolumes();
 }
 
-uint8 Channel::getFaderL() {
+uint8 Channel::getFaderL() const {
 	return _faderL;
 }
 
@@ -687,7 +1074,7 @@ void Channel::setFaderR(uint8 faderR) {
 	updateChannelVolumes();
 }
 
-uint8 Channel::getFaderR() {
+uint8 Channel::getFaderR() const {
 	return _faderR;
 }
 
@@ -696,7 +1083,7 @@ void Channel::setRate(uint32 rate) {
 		_converter->setInputRate(rate);
 }
 
-uint32 Channel::getRate() {
+uint32 Channel::getRate() const {
 	if (_converter)
 		return _converter->getInputRate();
 
@@ -793,7 +1180,7 @@ void Channel::loop() {
 	}
 }
 
-int Channel::mix(int16 *data, uint len) {
+int Channel::mix(int32 *data, uint len) {
 	assert(_stream);
 	assert(_converter);
 
@@ -802,7 +1189,7 @@ int Channel::mix(int16 *data, uint len) {
 		_samplesConsumed = _samplesDecoded;
 		_mixerTimeStamp = g_system->getMillis(true);
 		_pauseTime = 0;
-		res = _converter->convert(*_stream, data, len, _volL, _volR);
+		res = _converter->convertToMixBuffer(*_stream, data, len, _volL, _volR);
 		_samplesDecoded += res;
 	}
 
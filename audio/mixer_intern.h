@@ -25,6 +25,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -58,7 +59,9 @@ namespace Audio {
 class MixerImpl : public Mixer {
 private:
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		/** Mixing buffer size in frames when the backend gives no buffer size */
+		DEFAULT_MIX_BUFFER_FRAMES = 4096
 	};
 
 	Common::Mutex _mutex;
@@ -68,6 +71,7 @@ private:
 	const uint _outBufSize;
 	bool _mixerReady;
 	uint32 _handleSeed;
+	RateConverterQuality _rateConverterQuality;
 
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
@@ -79,6 +83,74 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	enum CommandType {
+		kCommandPauseAll,
+		kCommandPauseHandle,
+		kCommandSetVolume,
+		kCommandSetBalance,
+		kCommandSetFaderL,
+		kCommandSetFaderR,
+		kCommandSetRate,
+		kCommandResetRate,
+		kCommandLoop
+	};
+
+	/**
+	 * A channel operation posted by an engine thread while deferred
+	 * commands are enabled. It is applied by the mixer thread at the
+	 * start of the next mixCallback() run.
+	 */
+	struct Command {
+		CommandType type;
+		uint32 handle;
+		int id;
+		uint32 value;
+	};
+
+	enum {
+		COMMAND_QUEUE_SIZE = 256
+	};
+
+	/**
+	 * The engine side view of a channel, kept up to date while deferred
+	 * commands are enabled. The queries read it under _commandMutex
+	 * instead of _mutex, so that polling a sound does not wait for the
+	 * mixer thread.
+	 */
+	struct ChannelState {
+		ChannelState() : active(false), handle(0), id(-1), type(kPlainSoundType), volume(0), balance(0),
+			faderL(255), faderR(255), rate(0), nativeRate(0), pauseLevel(0) {}
+
+		bool active;
+		uint32 handle;
+		int id;
+		SoundType type;
+		byte volume;
+		int8 balance;
+		uint8 faderL;
+		uint8 faderR;
+		uint32 rate;
+		uint32 nativeRate;
+		int pauseLevel;
+	};
+
+	bool _deferredCommands;
+
+	/** Guards the command queue and the channel states. Never held for long. */
+	Common::Mutex _commandMutex;
+	Command _commands[COMMAND_QUEUE_SIZE];
+	uint _commandHead;
+	uint _commandCount;
+	ChannelState _channelStates[NUM_CHANNELS];
+
+	/**
+	 * The 32-bit intermediate buffer all channels are mixed into. It is
+	 * allocated up front so that the audio callback never allocates;
+	 * larger requests are mixed in several passes.
+	 */
+	int32 *_mixBuffer;
+	uint _mixBufferSize;
+
 
 public:
 
@@ -142,6 +214,13 @@ public:
 
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
+	void deleteChannel(int index);
+	void updateChannelState(int index);
+
+	bool findChannelState(SoundHandle handle, ChannelState &state) const;
+	bool postCommand(CommandType type, uint32 handle, int id, uint32 value);
+	void applyPendingCommands();
+	void applyCommand(const Command &cmd);
 
 public:
 	/**
@@ -161,6 +240,29 @@ public:
 	 * their audio system has been completed.
 	 */
 	void setReady(bool ready);
+
+	/**
+	 * Enable or disable deferred channel commands.
+	 *
+	 * When enabled, the engine facing channel setters (volume, balance,
+	 * faders, rate, pausing and looping) do not take the mixer mutex.
+	 * They post a command which mixCallback() applies before mixing the
+	 * next buffer, and the channel queries answer from a state copy
+	 * without locking. This keeps engines which poll the mixer in tight
+	 * loops from stalling the audio thread.
+	 *
+	 * Stopping a sound is still done right away, after applying the
+	 * pending commands, since callers may free the sound data as soon as
+	 * the stop call returns.
+	 *
+	 * This should be set up before the mixer is marked as ready.
+	 */
+	void setDeferredCommands(bool enable);
+
+	/**
+	 * Select the resampling algorithm used for channels started from now on.
+	 */
+	void setRateConverterQuality(RateConverterQuality quality);
 };
 
 /** @} */
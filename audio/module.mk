@@ -18,12 +18,14 @@ MODULE_OBJS := \
 	midiplayer.o \
 	miles_adlib.o \
 	miles_midi.o \
+	mixbuffer.o \
 	mixer.o \
 	mpu401.o \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
 	rate.o \
+	rate_sinc.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -65,6 +67,17 @@ MODULE_OBJS := \
 	softsynth/eas.o \
 	softsynth/pcspk.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	mixbuffer-sse2.o \
+	rate_sinc-sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	mixbuffer-avx2.o \
+	rate_sinc-avx2.o
+endif
+
 ifndef DISABLE_NUKED_OPL
 MODULE_OBJS += \
 	softsynth/opl/nuked.o
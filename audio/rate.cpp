@@ -29,6 +29,8 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/mixbuffer.h"
+#include "audio/rate_sinc.h"
 #include "audio/mixer.h"
 #include "common/util.h"
 
@@ -45,8 +47,93 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Common part of the rate converters: the actual resampling is done into
+ * a block of stereo frames in output channel order, which is then scaled
+ * and mixed into the output buffer.
+ */
+template<bool outStereo, bool reverseStereo>
+class RateConverter_Base : public RateConverter {
+private:
+	/**
+	 * The resampled output frames, as interleaved stereo pairs in output
+	 * channel order, before volume is applied and they are mixed.
+	 */
+	st_sample_t _frames[512];
+
+protected:
+	virtual int resample(AudioStream &input, st_sample_t *frames, st_size_t numFrames) = 0;
+
+public:
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+	int convertToMixBuffer(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+};
+
+template<bool outStereo, bool reverseStereo>
+int RateConverter_Base<outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	// The frames are stored in output channel order
+	const int vol0 = reverseStereo ? volR : volL;
+	const int vol1 = reverseStereo ? volL : volR;
+
+	st_size_t done = 0;
+	while (done < numSamples) {
+		const st_size_t chunk = MIN<st_size_t>(numSamples - done, ARRAYSIZE(_frames) / 2);
+		const int count = resample(input, _frames, chunk);
+
+		const st_sample_t *frames = _frames;
+		for (int i = 0; i < count; i++) {
+			st_sample_t out0, out1;
+			out0 = (frames[0] * vol0) / Audio::Mixer::kMaxMixerVolume;
+			out1 = (frames[1] * vol1) / Audio::Mixer::kMaxMixerVolume;
+			frames += 2;
+
+			if (outStereo) {
+				clampedAdd(outBuffer[0], out0);
+				clampedAdd(outBuffer[1], out1);
+				outBuffer += 2;
+			} else {
+				clampedAdd(outBuffer[0], (out0 + out1) / 2);
+				outBuffer += 1;
+			}
+		}
+
+		done += count;
+		if ((st_size_t)count < chunk)
+			break;
+	}
+
+	return done;
+}
+
+template<bool outStereo, bool reverseStereo>
+int RateConverter_Base<outStereo, reverseStereo>::convertToMixBuffer(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	// The frames are stored in output channel order
+	const st_volume_t vol0 = reverseStereo ? volR : volL;
+	const st_volume_t vol1 = reverseStereo ? volL : volR;
+
+	st_size_t done = 0;
+	while (done < numSamples) {
+		const st_size_t chunk = MIN<st_size_t>(numSamples - done, ARRAYSIZE(_frames) / 2);
+		const int count = resample(input, _frames, chunk);
+
+		if (outStereo) {
+			MixBuffer::mixStereo(outBuffer, _frames, count, vol0, vol1);
+			outBuffer += count * 2;
+		} else {
+			MixBuffer::mixMono(outBuffer, _frames, count, vol0, vol1);
+			outBuffer += count;
+		}
+
+		done += count;
+		if ((st_size_t)count < chunk)
+			break;
+	}
+
+	return done;
+}
+
 template<bool inStereo, bool outStereo, bool reverseStereo>
-class RateConverter_Impl : public RateConverter {
+class RateConverter_Impl : public RateConverter_Base<outStereo, reverseStereo> {
 private:
 	/** Input and output rates */
 	st_rate_t _inRate, _outRate;
@@ -76,16 +163,17 @@ private:
 	/** Current sample(s) in the input stream (left/right channel) */
 	st_sample_t _inCurL, _inCurR;
 
-	int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	int copyConvert(AudioStream &input, st_sample_t *frames, st_size_t numFrames);
+	int simpleConvert(AudioStream &input, st_sample_t *frames, st_size_t numFrames);
+	int interpolateConvert(AudioStream &input, st_sample_t *frames, st_size_t numFrames);
+
+protected:
+	int resample(AudioStream &input, st_sample_t *frames, st_size_t numFrames) override;
 
 public:
 	RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate);
 	virtual ~RateConverter_Impl() {}
 
-	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
-
 	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; }
 	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; }
 
@@ -96,62 +184,46 @@ public:
 };
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *frames, st_size_t numFrames) {
 	st_sample_t *outStart, *outEnd;
 
-	outStart = outBuffer;
-	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+	outStart = frames;
+	outEnd = frames + numFrames * 2;
 
-	while (outBuffer < outEnd) {
+	while (frames < outEnd) {
 		// Check if we have to refill the buffer
 		if (_bufferSize == 0) {
 			_bufferPos = _buffer;
 			_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
 
 			if (_bufferSize <= 0)
-				return (outBuffer - outStart) / (outStereo ? 2 : 1);
+				return (frames - outStart) / 2;
 		}
 
-		// Mix the data into the output buffer
 		st_sample_t inL, inR;
 		inL = *_bufferPos++;
 		inR = (inStereo ? *_bufferPos++ : inL);
 		_bufferSize -= (inStereo ? 2 : 1);
 
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
-		}
+		frames[reverseStereo    ] = inL;
+		frames[reverseStereo ^ 1] = inR;
+		frames += 2;
 	}
 
-	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+	return (frames - outStart) / 2;
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, st_sample_t *frames, st_size_t numFrames) {
 	// How much to increment _outPos by
 	frac_t outPos_inc = _inRate / _outRate;
 
 	st_sample_t *outStart, *outEnd;
 
-	outStart = outBuffer;
-	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+	outStart = frames;
+	outEnd = frames + numFrames * 2;
 
-	while (outBuffer < outEnd) {
+	while (frames < outEnd) {
 		// Read enough input samples so that _outPos >= 0
 		do {
 			// Check if we have to refill the buffer
@@ -160,7 +232,7 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
 
 				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+					return (frames - outStart) / 2;
 			}
 
 			_bufferSize -= (inStereo ? 2 : 1);
@@ -178,38 +250,23 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 		// Increment output position
 		_outPos += outPos_inc;
 
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
-		}
+		frames[reverseStereo    ] = inL;
+		frames[reverseStereo ^ 1] = inR;
+		frames += 2;
 	}
-	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+	return (frames - outStart) / 2;
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, st_sample_t *frames, st_size_t numFrames) {
 	// How much to increment _outPosFrac by
 	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
 
 	st_sample_t *outStart, *outEnd;
-	outStart = outBuffer;
-	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+	outStart = frames;
+	outEnd = frames + numFrames * 2;
 
-	while (outBuffer < outEnd) {
+	while (frames < outEnd) {
 		// Read enough input samples so that _outPosFrac < 0
 		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
 			// Check if we have to refill the buffer
@@ -218,7 +275,7 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
 
 				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+					return (frames - outStart) / 2;
 			}
 
 			_bufferSize -= (inStereo ? 2 : 1);
@@ -235,7 +292,7 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 
 		// Loop as long as the _outPos trails behind, and as long as there is
 		// still space in the output buffer.
-		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
+		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && frames < outEnd) {
 			// Interpolate
 			st_sample_t inL, inR;
 			inL = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
@@ -243,30 +300,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 						(st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
 						inL);
 
-			st_sample_t outL, outR;
-			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-			if (outStereo) {
-				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
-
-				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-				outBuffer += 2;
-			} else {
-				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-				outBuffer += 1;
-			}
+			frames[reverseStereo    ] = inL;
+			frames[reverseStereo ^ 1] = inR;
+			frames += 2;
 
 			// Increment output position
 			_outPosFrac += outPos_inc;
 		}
 	}
-	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+	return (frames - outStart) / 2;
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
@@ -283,35 +325,222 @@ RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_ra
 	_bufferPos(nullptr) {}
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::resample(AudioStream &input, st_sample_t *frames, st_size_t numFrames) {
 	assert(input.isStereo() == inStereo);
 
 	if (_inRate == _outRate) {
-		return copyConvert(input, outBuffer, numSamples, volL, volR);
+		return copyConvert(input, frames, numFrames);
 	} else {
 		if ((_inRate % _outRate) == 0 && (_inRate < 65536)) {
-			return simpleConvert(input, outBuffer, numSamples, volL, volR);
+			return simpleConvert(input, frames, numFrames);
 		} else {
-			return interpolateConvert(input, outBuffer, numSamples, volL, volR);
+			return interpolateConvert(input, frames, numFrames);
 		}
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+/**
+ * The shared filter table used for upsampling, where the cutoff does not
+ * depend on the conversion ratio.
+ */
+static int16 s_sincTable[SincFilter::kNumPhases * SincFilter::kNumTaps];
+static bool s_sincTableReady = false;
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+class SincRateConverter : public RateConverter_Base<outStereo, reverseStereo> {
+private:
+	enum {
+		/** Number of planar input samples kept per channel */
+		kBufferSize = 1024,
+
+		/**
+		 * Cutoff relative to the Nyquist frequency of the lower rate, in
+		 * 1/kCutoffSteps units. It leaves room for the transition band of
+		 * the short filter, so that images and aliases are suppressed.
+		 */
+		kCutoffSteps = 64,
+		kCutoff = 58
+	};
+
+	/** Input and output rates */
+	st_rate_t _inRate, _outRate;
+
+	/** The interleaved input read from the stream */
+	st_sample_t _buffer[512];
+
+	/** Planar input samples (left/right channel), including the filter history */
+	st_sample_t _inL[kBufferSize], _inR[kBufferSize];
+
+	/** Number of valid samples in _inL and _inR */
+	uint _inCount;
+
+	/** Position of the first filter tap for the next output sample, and its increment */
+	uint32 _pos, _step;
+
+	/** The filter table in use, either the shared one or _ownTable */
+	const int16 *_table;
+
+	/** Filter table for downsampling, which depends on the conversion ratio */
+	int16 *_ownTable;
+	int _ownCutoff;
+
+	void updateFilter();
+
+protected:
+	int resample(AudioStream &input, st_sample_t *frames, st_size_t numFrames) override;
+
+public:
+	SincRateConverter(st_rate_t inputRate, st_rate_t outputRate);
+	virtual ~SincRateConverter() { delete[] _ownTable; }
+
+	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; updateFilter(); }
+	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; updateFilter(); }
+
+	st_rate_t getInputRate() const override { return _inRate; }
+	st_rate_t getOutputRate() const override { return _outRate; }
+
+	bool needsDraining() const override { return (_pos >> SincFilter::FRAC_BITS) + SincFilter::kNumTaps <= _inCount; }
+};
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+SincRateConverter<inStereo, outStereo, reverseStereo>::SincRateConverter(st_rate_t inputRate, st_rate_t outputRate) :
+	_inRate(inputRate),
+	_outRate(outputRate),
+	_inCount(SincFilter::kNumTaps / 2 - 1),
+	_pos(0),
+	_step(0),
+	_table(s_sincTable),
+	_ownTable(nullptr),
+	_ownCutoff(0) {
+	// Converters are created by the engine thread, so this does not race
+	// with any mixing thread.
+	if (!s_sincTableReady) {
+		SincFilter::makeTable(s_sincTable, (double)kCutoff / kCutoffSteps);
+		s_sincTableReady = true;
+	}
+
+	// The history starts out silent, so that the first output sample
+	// is centered on the first input sample.
+	memset(_inL, 0, sizeof(_inL));
+	memset(_inR, 0, sizeof(_inR));
+
+	updateFilter();
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void SincRateConverter<inStereo, outStereo, reverseStereo>::updateFilter() {
+	_step = (uint32)(((uint64)_inRate << SincFilter::FRAC_BITS) / _outRate);
+
+	if (_inRate <= _outRate) {
+		_table = s_sincTable;
+		return;
+	}
+
+	// When downsampling, the cutoff has to follow the output rate. It is
+	// quantized so that small rate changes do not rebuild the table.
+	const int cutoff = MAX<int>(1, (int)((uint64)kCutoff * _outRate / _inRate));
+	if (!_ownTable)
+		_ownTable = new int16[SincFilter::kNumPhases * SincFilter::kNumTaps];
+	if (cutoff != _ownCutoff) {
+		SincFilter::makeTable(_ownTable, (double)cutoff / kCutoffSteps);
+		_ownCutoff = cutoff;
+	}
+	_table = _ownTable;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int SincRateConverter<inStereo, outStereo, reverseStereo>::resample(AudioStream &input, st_sample_t *frames, st_size_t numFrames) {
+	assert(input.isStereo() == inStereo);
+
+	const uint32 fracMask = (1 << SincFilter::FRAC_BITS) - 1;
+	st_size_t produced = 0;
+
+	while (produced < numFrames) {
+		const uint base = _pos >> SincFilter::FRAC_BITS;
+
+		if (base + SincFilter::kNumTaps <= _inCount) {
+			// Produce as many samples as the buffered input allows
+			const uint lastBase = _inCount - SincFilter::kNumTaps;
+			uint count = (uint)((((uint64)(lastBase + 1) << SincFilter::FRAC_BITS) - _pos + _step - 1) / _step);
+			count = MIN<uint>(count, numFrames - produced);
+
+			st_sample_t *out = frames + produced * 2;
+			if (_step == (1 << SincFilter::FRAC_BITS) && !(_pos & fracMask)) {
+				// Matching rates pass through unchanged
+				const uint center = base + SincFilter::kNumTaps / 2 - 1;
+				for (uint i = 0; i < count; i++) {
+					out[i * 2 + reverseStereo    ] = _inL[center + i];
+					out[i * 2 + (reverseStereo ^ 1)] = (inStereo ? _inR : _inL)[center + i];
+				}
+			} else {
+				SincFilter::filter(out + reverseStereo, _inL, _table, _pos, _step, count);
+				if (inStereo) {
+					SincFilter::filter(out + (reverseStereo ^ 1), _inR, _table, _pos, _step, count);
+				} else {
+					for (uint i = 0; i < count; i++)
+						out[i * 2 + 1] = out[i * 2];
+				}
+			}
+
+			_pos += count * _step;
+			produced += count;
+			continue;
+		}
+
+		// Drop the input which is no longer needed and refill the buffer
+		const uint discard = MIN<uint>(base, _inCount);
+		if (discard) {
+			memmove(_inL, _inL + discard, (_inCount - discard) * sizeof(st_sample_t));
+			if (inStereo)
+				memmove(_inR, _inR + discard, (_inCount - discard) * sizeof(st_sample_t));
+			_inCount -= discard;
+			_pos -= discard << SincFilter::FRAC_BITS;
+		}
+
+		const uint space = MIN<uint>(kBufferSize - _inCount, ARRAYSIZE(_buffer) / (inStereo ? 2 : 1));
+		const int numRead = input.readBuffer(_buffer, space * (inStereo ? 2 : 1));
+		if (numRead <= 0)
+			break;
+
+		const st_sample_t *src = _buffer;
+		if (inStereo) {
+			for (int i = 0; i < numRead / 2; i++) {
+				_inL[_inCount + i] = *src++;
+				_inR[_inCount + i] = *src++;
+			}
+			_inCount += numRead / 2;
+		} else {
+			memcpy(_inL + _inCount, src, numRead * sizeof(st_sample_t));
+			_inCount += numRead;
+		}
+	}
+
+	return produced;
+}
+
+template<template<bool, bool, bool> class T>
+static RateConverter *makeRateConverterImpl(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
-				return new RateConverter_Impl<true, true, true>(inRate, outRate);
+				return new T<true, true, true>(inRate, outRate);
 			else
-				return new RateConverter_Impl<true, true, false>(inRate, outRate);
+				return new T<true, true, false>(inRate, outRate);
 		} else
-			return new RateConverter_Impl<true, false, false>(inRate, outRate);
+			return new T<true, false, false>(inRate, outRate);
 	} else {
 		if (outStereo) {
-			return new RateConverter_Impl<false, true, false>(inRate, outRate);
+			return new T<false, true, false>(inRate, outRate);
 		} else
-			return new RateConverter_Impl<false, false, false>(inRate, outRate);
+			return new T<false, false, false>(inRate, outRate);
 	}
 }
 
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterQuality quality) {
+	if (quality == kRateConverterSinc)
+		return makeRateConverterImpl<SincRateConverter>(inRate, outRate, inStereo, outStereo, reverseStereo);
+
+	return makeRateConverterImpl<RateConverter_Impl>(inRate, outRate, inStereo, outStereo, reverseStereo);
+}
+
 } // End of namespace Audio
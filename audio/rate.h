@@ -90,6 +90,15 @@ public:
 	 */
 	virtual int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Convert the provided AudioStream to the target sample rate and add it
+	 * to a 32-bit mixing buffer. Unlike convert(), no clamping is done, so
+	 * the caller has to saturate the buffer once all streams are mixed.
+	 *
+	 * @see convert(), MixBuffer::saturate()
+	 */
+	virtual int convertToMixBuffer(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual void setInputRate(st_rate_t inputRate) = 0;
 	virtual void setOutputRate(st_rate_t outputRate) = 0;
 
@@ -104,7 +113,25 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+/**
+ * The resampling algorithms a RateConverter can use.
+ */
+enum RateConverterQuality {
+	/**
+	 * Nearest neighbour for integer ratios, linear interpolation otherwise.
+	 * This is the cheapest option and the default.
+	 */
+	kRateConverterLinear,
+
+	/**
+	 * Band-limited polyphase windowed-sinc filter. It suppresses most of
+	 * the aliasing the linear converter produces when upsampling low rate
+	 * audio, at the cost of a 16 tap filter per output sample.
+	 */
+	kRateConverterSinc
+};
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterQuality quality = kRateConverterLinear);
 
 /** @} */
 } // End of namespace Audio
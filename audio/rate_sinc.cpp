@@ -0,0 +1,107 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/rate_sinc.h"
+#include "common/system.h"
+
+namespace Audio {
+
+SincFilter::FilterFunc SincFilter::filterFunc = nullptr;
+
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+void SincFilter::makeTable(int16 *table, double cutoff) {
+	// Kaiser window parameter, which gives about 60 dB of stopband
+	// attenuation with the short filter we use.
+	const double beta = 6.0;
+	const double halfWidth = kNumTaps / 2;
+
+	for (int phase = 0; phase < kNumPhases; phase++) {
+		const double frac = (double)phase / kNumPhases;
+		double coefs[kNumTaps];
+		double sum = 0.0;
+
+		for (int k = 0; k < kNumTaps; k++) {
+			// Distance to the output sample, which lies between the two
+			// taps in the middle of the window.
+			const double t = k - (kNumTaps / 2 - 1) - frac;
+			const double x = t * cutoff * M_PI;
+			const double sinc = (x == 0.0) ? 1.0 : sin(x) / x;
+			const double w = t / halfWidth;
+			const double window = (w <= -1.0 || w >= 1.0) ? 0.0 : besselI0(beta * sqrt(1.0 - w * w)) / besselI0(beta);
+
+			coefs[k] = sinc * window;
+			sum += coefs[k];
+		}
+
+		// Normalize to unity gain, and correct the rounding error on the
+		// largest tap so that DC passes through unchanged.
+		int16 *dst = table + phase * kNumTaps;
+		int total = 0, largest = 0;
+		for (int k = 0; k < kNumTaps; k++) {
+			dst[k] = (int16)floor(coefs[k] / sum * (1 << kCoefBits) + 0.5);
+			total += dst[k];
+			if (dst[k] > dst[largest])
+				largest = k;
+		}
+		dst[largest] += (1 << kCoefBits) - total;
+	}
+}
+
+void SincFilter::filter(st_sample_t *out, const st_sample_t *in, const int16 *table, uint32 pos, uint32 step, uint count) {
+	if (!filterFunc) {
+		filterFunc = filterGeneric;
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) filterFunc = filterSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) filterFunc = filterAVX2;
+#endif
+	}
+
+	filterFunc(out, in, table, pos, step, count);
+}
+
+void SincFilter::filterGeneric(st_sample_t *out, const st_sample_t *in, const int16 *table, uint32 pos, uint32 step, uint count) {
+	while (count--) {
+		const st_sample_t *src = in + (pos >> FRAC_BITS);
+		const int16 *coefs = getCoefs(table, pos);
+
+		int32 sum = 0;
+		for (int k = 0; k < kNumTaps; k++)
+			sum += src[k] * coefs[k];
+
+		*out = clampOutput(sum);
+		out += 2;
+		pos += step;
+	}
+}
+
+} // End of namespace Audio
@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RATE_SINC_H
+#define AUDIO_RATE_SINC_H
+
+#include "common/scummsys.h"
+#include "audio/rate.h"
+
+class SincFilterTestSuite;
+
+namespace Audio {
+
+/**
+ * @defgroup audio_rate_sinc Polyphase sinc filter
+ * @ingroup audio
+ *
+ * @brief Filter kernels used by the windowed-sinc rate converter.
+ * @{
+ */
+
+/**
+ * The filter kernels of the polyphase windowed-sinc rate converter.
+ *
+ * Input samples are planar, output samples are written to every other
+ * st_sample_t, so that the left and right channels can be filtered
+ * separately into interleaved frames. Positions are fixed point values
+ * with FRAC_BITS fractional bits and address the first of the kNumTaps
+ * input samples used for an output sample.
+ */
+class SincFilter {
+public:
+	enum {
+		kNumTaps = 16,
+		kPhaseBits = 8,
+		kNumPhases = 1 << kPhaseBits,
+		kCoefBits = 14,
+
+		FRAC_BITS = 20
+	};
+
+	/**
+	 * Compute the coefficient table for the given cutoff frequency,
+	 * relative to the input Nyquist frequency.
+	 *
+	 * @param table  Buffer for kNumPhases * kNumTaps coefficients.
+	 * @param cutoff Cutoff frequency in the range (0, 1].
+	 */
+	static void makeTable(int16 *table, double cutoff);
+
+	/**
+	 * Filter count output samples, starting at position pos.
+	 */
+	static void filter(st_sample_t *out, const st_sample_t *in, const int16 *table, uint32 pos, uint32 step, uint count);
+
+private:
+	typedef void(*FilterFunc)(st_sample_t *, const st_sample_t *, const int16 *, uint32, uint32, uint);
+
+	static FilterFunc filterFunc;
+
+	static void filterGeneric(st_sample_t *out, const st_sample_t *in, const int16 *table, uint32 pos, uint32 step, uint count);
+#ifdef SCUMMVM_SSE2
+	static void filterSSE2(st_sample_t *out, const st_sample_t *in, const int16 *table, uint32 pos, uint32 step, uint count);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void filterAVX2(st_sample_t *out, const st_sample_t *in, const int16 *table, uint32 pos, uint32 step, uint count);
+#endif
+
+	static FORCEINLINE st_sample_t clampOutput(int32 sum) {
+		sum = (sum + (1 << (kCoefBits - 1))) >> kCoefBits;
+		if (sum > ST_SAMPLE_MAX)
+			return ST_SAMPLE_MAX;
+		if (sum < ST_SAMPLE_MIN)
+			return ST_SAMPLE_MIN;
+		return (st_sample_t)sum;
+	}
+
+	static FORCEINLINE const int16 *getCoefs(const int16 *table, uint32 pos) {
+		return table + ((pos >> (FRAC_BITS - kPhaseBits)) & (kNumPhases - 1)) * kNumTaps;
+	}
+
+	friend class ::SincFilterTestSuite;
+};
+
+/** @} */
+} // End of namespace Audio
+
+#endif
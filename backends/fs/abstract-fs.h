@@ -192,6 +192,18 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType);
 
+	/**
+	 * Queries the size and last modification time of the file referred by
+	 * this node without opening it. Backends which cannot provide this
+	 * information cheaply return false.
+	 *
+	 * @param size  receives the file size in bytes
+	 * @param mtime receives the modification time, in a backend specific unit
+	 *
+	 * @return true if the information is available, false otherwise
+	 */
+	virtual bool getFileStat(int64 &size, int64 &mtime) const;
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
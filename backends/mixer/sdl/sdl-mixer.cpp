@@ -144,6 +144,10 @@ void SdlMixerManager::init() {
 
 	_mixer = new Audio::MixerImpl(_obtained.freq, _obtained.channels >= 2, desiredSamples);
 	assert(_mixer);
+	if (ConfMan.hasKey("mixer_deferred_commands") && ConfMan.getBool("mixer_deferred_commands"))
+		_mixer->setDeferredCommands(true);
+	if (ConfMan.get("resampler") == "sinc")
+		_mixer->setRateConverterQuality(Audio::kRateConverterSinc);
 	_mixer->setReady(true);
 
 	startAudio();
@@ -38,6 +38,8 @@
 #include "common/config-manager.h"
 #include "common/compression/deflate.h"
 
+#include "engines/metaengine.h"
+
 #include <errno.h>	// for removeSavefile()
 
 #ifdef USE_CLOUD
@@ -144,6 +146,9 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		}
 	}
 
+	// The metadata recorded for the previous contents is outdated
+	MetaEngine::invalidateSaveMetaInfos(filename);
+
 #ifdef USE_CLOUD
 	// Update file's timestamp
 	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
@@ -181,6 +186,8 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	if (getError().getCode() != Common::kNoError)
 		return false;
 
+	MetaEngine::invalidateSaveMetaInfos(filename);
+
 #ifdef USE_CLOUD
 	// Update file's timestamp
 	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
@@ -235,6 +242,19 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+bool DefaultSaveFileManager::getSavefileStat(const Common::String &filename, int64 &size, int64 &mtime) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return false;
+
+	return file->_value.getFileStat(size, mtime);
+}
+
 Common::Path DefaultSaveFileManager::getSavePath() const {
 
 	Common::Path dir;
@@ -43,6 +43,7 @@ public:
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	bool getSavefileStat(const Common::String &filename, int64 &size, int64 &mtime) override;
 
 #ifdef USE_CLOUD
 
@@ -208,6 +208,9 @@ static const char HELP_STRING4[] =
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
 	"                           (default: 60000)\n"
 	"  --list-records           Display a list of recordings for the target specified\n"
+	"  --benchmark=FILE         Play back recording FILE as fast as possible without any\n"
+	"                           display and write frame timings to a JSON report\n"
+	"  --benchmark-report=FILE  Specify the benchmark report file (default: benchmark.json)\n"
 #endif
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
@@ -377,10 +380,14 @@ void registerDefaults() {
 	ConfMan.registerDefault("confirm_exit", false);
 	ConfMan.registerDefault("disable_sdl_parachute", false);
 	ConfMan.registerDefault("disable_sdl_audio", false);
+	ConfMan.registerDefault("mixer_deferred_commands", false);
+	ConfMan.registerDefault("resampler", "linear");
+	ConfMan.registerDefault("archive_cache_size", 4096);
 
 	ConfMan.registerDefault("disable_display", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
+	ConfMan.registerDefault("benchmark_report", "benchmark.json");
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
@@ -813,6 +820,15 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION_INT("screenshot-period")
 			END_OPTION
+
+			DO_LONG_OPTION("benchmark")
+				settings["record-mode"] = "playback";
+				settings["record-file-name"] = option;
+				settings["disable-display"] = "1";
+			END_OPTION
+
+			DO_LONG_OPTION("benchmark-report")
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
@@ -30,6 +30,7 @@
 // FIXME: Avoid using printf
 #define FORBIDDEN_SYMBOL_EXCEPTION_printf
 
+#include "engines/advancedDetector.h"
 #include "engines/engine.h"
 #include "engines/metaengine.h"
 #include "base/commandLine.h"
@@ -526,6 +527,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		if (res.getCode() != Common::kNoError)
 			warning("%s", res.getDesc().c_str());
 
+		AdvancedDetectorCacheManager::destroy();
 		PluginManager::destroy();
 
 		return res.getCode();
@@ -599,6 +601,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	MusicManager::instance();
 	Common::DebugManager::instance();
 
+	// Keep recently used compressed archive members in memory, up to the
+	// configured amount of kilobytes
+	Common::MemcachingCaseInsensitiveArchive::setSharedCacheBudget(MAX(ConfMan.getInt("archive_cache_size"), 0) * 1024);
+
 	// Init the event manager. As the virtual keyboard is loaded here, it must
 	// take place after the backend is initiated and the screen has been setup
 	system.getEventManager()->init();
@@ -895,6 +901,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	//I think it's important to destroy it after ConnectionManager
 	Cloud::CloudManager::destroy();
 #endif
+	AdvancedDetectorCacheManager::destroy();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
 	Common::ConfigManager::destroy();
@@ -697,6 +697,9 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 	// Close all archives that were opened during detection
 	ADCacheMan.clearArchives();
 
+	// Keep the computed hashes for the next scan
+	ADCacheMan.flushPersistentCache(false);
+
 	return DetectionResults(candidates);
 }
 
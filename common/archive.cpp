@@ -230,6 +230,80 @@ void Archive::prepareMaps() const {
 	}
 }
 
+MemcachingCaseInsensitiveArchive::SharedCacheList *MemcachingCaseInsensitiveArchive::_sharedCache = nullptr;
+uint32 MemcachingCaseInsensitiveArchive::_sharedCacheBudget = 0;
+MemcachingCaseInsensitiveArchive::CacheStats MemcachingCaseInsensitiveArchive::_sharedCacheStats;
+
+MemcachingCaseInsensitiveArchive::~MemcachingCaseInsensitiveArchive() {
+	// Release our members from the shared cache
+	for (const auto &ref : _sharedCacheRefs) {
+		_sharedCacheStats.usedBytes -= ref._value->size;
+		_sharedCache->erase(ref._value);
+	}
+}
+
+void MemcachingCaseInsensitiveArchive::setSharedCacheBudget(uint32 bytes) {
+	_sharedCacheBudget = bytes;
+	_sharedCacheStats.budget = bytes;
+	evictSharedCache(bytes);
+}
+
+MemcachingCaseInsensitiveArchive::CacheStats MemcachingCaseInsensitiveArchive::getSharedCacheStats() {
+	return _sharedCacheStats;
+}
+
+void MemcachingCaseInsensitiveArchive::resetSharedCacheStats() {
+	_sharedCacheStats.hits = 0;
+	_sharedCacheStats.misses = 0;
+	_sharedCacheStats.evictions = 0;
+}
+
+void MemcachingCaseInsensitiveArchive::evictSharedCache(uint32 budget) {
+	if (!_sharedCache)
+		return;
+
+	while (_sharedCacheStats.usedBytes > budget) {
+		const SharedCacheEntry &victim = _sharedCache->back();
+		victim.owner->_sharedCacheRefs.erase(victim.key);
+		_sharedCacheStats.usedBytes -= victim.size;
+		_sharedCacheStats.evictions++;
+		_sharedCache->pop_back();
+	}
+
+	if (_sharedCache->empty()) {
+		delete _sharedCache;
+		_sharedCache = nullptr;
+	}
+}
+
+void MemcachingCaseInsensitiveArchive::touchSharedCache(const CacheKey &key, const SharedArchiveContents &contents) const {
+	if (contents.getSize() > _sharedCacheBudget)
+		return;
+
+	SharedCacheEntry entry;
+
+	if (_sharedCacheRefs.contains(key)) {
+		// Move the member to the front of the LRU list
+		SharedCacheList::iterator it = _sharedCacheRefs[key];
+		entry = *it;
+		_sharedCache->erase(it);
+	} else {
+		entry.owner = this;
+		entry.key = key;
+		entry.contents = contents.getContents();
+		entry.size = contents.getSize();
+		_sharedCacheStats.usedBytes += entry.size;
+
+		if (!_sharedCache)
+			_sharedCache = new SharedCacheList();
+	}
+
+	_sharedCache->push_front(entry);
+	_sharedCacheRefs[key] = _sharedCache->begin();
+
+	evictSharedCache(_sharedCacheBudget);
+}
+
 SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMember(const Path &path) const {
 	return createReadStreamForMemberImpl(path, false, Common::AltStreamType::Invalid);
 }
@@ -256,6 +330,7 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberI
 			return readResult._bypass;
 		_cache[cacheKey] = readResult;
 		isNew = true;
+		_sharedCacheStats.misses++;
 	}
 
 	SharedArchiveContents* entry = &_cache[cacheKey];
@@ -274,6 +349,9 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberI
 		_cache[cacheKey] = readResult;
 		entry = &_cache[cacheKey];
 		isNew = true;
+		_sharedCacheStats.misses++;
+	} else if (!isNew) {
+		_sharedCacheStats.hits++;
 	}
 
 	// It's possible that recreation failed in case of e.g. network
@@ -284,9 +362,11 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberI
 	// Now we have a valid contents reference. Make stream for it.
 	Common::MemoryReadStream *memStream = new Common::MemoryReadStream(entry->getContents(), entry->getSize());
 
-	// If the entry was just created and it's too big for strong caching,
-	// mark the copy in cache as weak
-	if (isNew && entry->getSize() > _maxStronglyCachedSize) {
+	// If the entry is too big for strong caching, mark the copy in cache as
+	// weak and let the shared cache decide how long it stays in memory
+	if (entry->getSize() > _maxStronglyCachedSize) {
+		if (_sharedCacheBudget)
+			touchSharedCache(cacheKey, *entry);
 		entry->makeWeak();
 	}
 
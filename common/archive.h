@@ -286,7 +286,19 @@ private:
  */
 class MemcachingCaseInsensitiveArchive : public Archive {
 public:
+	/**
+	 * Counters for the member cache shared by all memcaching archives.
+	 */
+	struct CacheStats {
+		uint32 hits;      ///< Member reads served from memory.
+		uint32 misses;    ///< Member reads which had to load the contents from the archive.
+		uint32 evictions; ///< Members dropped from the shared cache to stay within its budget.
+		uint32 usedBytes; ///< Bytes currently held by the shared cache.
+		uint32 budget;    ///< Maximum number of bytes held by the shared cache.
+	};
+
 	MemcachingCaseInsensitiveArchive(uint32 maxStronglyCachedSize = 512) : _maxStronglyCachedSize(maxStronglyCachedSize) {}
+	~MemcachingCaseInsensitiveArchive();
 	SeekableReadStream *createReadStreamForMember(const Path &path) const;
 	SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, Common::AltStreamType altStreamType) const;
 
@@ -297,6 +309,25 @@ public:
 	virtual SharedArchiveContents readContentsForPath(const Path &translatedPath) const = 0;
 	virtual SharedArchiveContents readContentsForPathAltStream(const Path &translatedPath, AltStreamType altStreamType) const;
 
+	/**
+	 * Set the size of the least recently used member cache shared by all
+	 * memcaching archives.
+	 *
+	 * Members bigger than the strong caching threshold of their archive are
+	 * otherwise released as soon as their last stream is destroyed, and have
+	 * to be read and decompressed again when reopened. Setting the budget
+	 * to 0 disables the shared cache.
+	 *
+	 * @param bytes Maximum number of bytes kept alive by the shared cache.
+	 */
+	static void setSharedCacheBudget(uint32 bytes);
+
+	/** Return the counters of the shared member cache. */
+	static CacheStats getSharedCacheStats();
+
+	/** Reset the hit, miss and eviction counters of the shared member cache. */
+	static void resetSharedCacheStats();
+
 private:
 	struct CacheKey {
 		CacheKey();
@@ -305,6 +336,15 @@ private:
 		AltStreamType altStreamType;
 	};
 
+	struct SharedCacheEntry {
+		const MemcachingCaseInsensitiveArchive *owner;
+		CacheKey key;
+		SharedPtr<byte> contents;
+		uint32 size;
+	};
+
+	typedef List<SharedCacheEntry> SharedCacheList;
+
 	struct CacheKey_EqualTo {
 		bool operator()(const CacheKey &x, const CacheKey &y) const;
 	};
@@ -314,9 +354,16 @@ private:
 	};
 
 	SeekableReadStream *createReadStreamForMemberImpl(const Path &path, bool isAltStream, Common::AltStreamType altStreamType) const;
+	void touchSharedCache(const CacheKey &key, const SharedArchiveContents &contents) const;
+	static void evictSharedCache(uint32 budget);
 
 	mutable HashMap<CacheKey, SharedArchiveContents, CacheKey_Hash, CacheKey_EqualTo> _cache;
+	mutable HashMap<CacheKey, SharedCacheList::iterator, CacheKey_Hash, CacheKey_EqualTo> _sharedCacheRefs;
 	uint32 _maxStronglyCachedSize;
+
+	static SharedCacheList *_sharedCache;
+	static uint32 _sharedCacheBudget;
+	static CacheStats _sharedCacheStats;
 };
 
 /**
@@ -95,6 +95,8 @@ typedef Byte Bytef;
 #include "common/compression/deflate.h"
 #include "common/compression/unzip.h"
 #include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/substream.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -232,6 +234,82 @@ Common::SharedArchiveContents unzOpenCurrentFile(unzFile file
 		, const Common::CRC32& crc
 #endif
 		);
+/*
+  Stream over a member stored in the zipfile. It keeps the zipfile stream
+  alive, so it can outlive the archive it was opened from.
+*/
+class UnzMemberReadStream : public Common::SafeSeekableSubReadStream {
+public:
+	UnzMemberReadStream(const Common::SharedPtr<Common::SeekableReadStream> &stream, uint32 begin, uint32 end)
+		: Common::SafeSeekableSubReadStream(stream.get(), begin, end, DisposeAfterUse::NO), _stream(stream) {
+	}
+
+private:
+	Common::SharedPtr<Common::SeekableReadStream> _stream;
+};
+
+/*
+  Checks the CRC32 of a streamed member once it has been read up to its end.
+  Data skipped by seeking forward is never read, so it can not be checked.
+*/
+class UnzCrcCheckingReadStream : public Common::SeekableReadStream {
+public:
+	UnzCrcCheckingReadStream(Common::SeekableReadStream *parent, uint32 expectedCrc)
+		: _parent(parent), _expectedCrc(expectedCrc), _crcPos(0), _crcError(false) {
+#ifdef USE_ZLIB
+		_crc = crc32(0, nullptr, 0);
+#else
+		_crc = _crcCalc.getInitRemainder();
+#endif
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		int64 start = _parent->pos();
+		uint32 len = _parent->read(dataPtr, dataSize);
+
+		if (start <= _crcPos && start + len > _crcPos) {
+			const byte *data = (const byte *)dataPtr + (_crcPos - start);
+			uint32 count = (uint32)(start + len - _crcPos);
+#ifdef USE_ZLIB
+			_crc = crc32(_crc, data, count);
+#else
+			for (uint32 i = 0; i < count; i++)
+				_crc = _crcCalc.processByte(data[i], _crc);
+#endif
+			_crcPos += count;
+
+			if (_crcPos == _parent->size()) {
+#ifndef USE_ZLIB
+				_crc = _crcCalc.finalize(_crc);
+#endif
+				if (_crc != _expectedCrc) {
+					warning("CRC32 mismatch: %08x, %08x", _crc, _expectedCrc);
+					_crcError = true;
+				}
+			}
+		}
+		return len;
+	}
+
+	bool eos() const override { return _parent->eos(); }
+	bool err() const override { return _crcError || _parent->err(); }
+	void clearErr() override { _parent->clearErr(); }
+
+	int64 pos() const override { return _parent->pos(); }
+	int64 size() const override { return _parent->size(); }
+	bool seek(int64 offset, int whence = SEEK_SET) override { return _parent->seek(offset, whence); }
+
+private:
+	Common::ScopedPtr<Common::SeekableReadStream> _parent;
+	uint32 _expectedCrc;
+	uint32 _crc;
+	int64 _crcPos;
+	bool _crcError;
+#ifndef USE_ZLIB
+	Common::CRC32 _crcCalc;
+#endif
+};
+
 /*
   Open for reading data the current file in the zipfile.
   If there is no error, the return value is UNZ_OK.
@@ -284,6 +362,17 @@ int unzGetLocalExtrafield(unzFile file, voidp buf, unsigned len);
 #define UNZ_MAXFILENAMEINZIP (256)
 #endif
 
+/* members bigger than this are streamed instead of being loaded into memory */
+#ifndef UNZ_MAX_IN_MEMORY_SIZE
+#define UNZ_MAX_IN_MEMORY_SIZE (4 * 1024 * 1024)
+#endif
+
+/* deflated members are only streamed when the inflate stream can seek back
+   without starting over from the beginning, see GZipReadStream */
+#if defined(USE_ZLIB) && ZLIB_VERNUM >= 0x1271
+#define UNZ_STREAM_DEFLATED_MEMBERS
+#endif
+
 #define SIZECENTRALDIRITEM (0x2e)
 #define SIZEZIPLOCALHEADER (0x1e)
 
@@ -325,6 +414,7 @@ typedef Common::HashMap<Common::Path, cached_file_in_zip, Common::Path::IgnoreCa
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _streamRef;	/* owns _stream, shared with streamed members */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -521,6 +611,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		return nullptr;
 	}
 
+	us->_streamRef.reset(us->_stream);
 	us->byte_before_the_zipfile = central_pos -
 		                    (us->offset_central_dir + us->size_central_dir);
 	us->central_pos = central_pos;
@@ -606,7 +697,7 @@ int unzClose(unzFile file) {
 		return UNZ_PARAMERROR;
 	s = (unz_s *)file;
 
-	delete s->_stream;
+	/* the stream is only deleted once no streamed member uses it anymore */
 	delete s;
 	return UNZ_OK;
 }
@@ -988,9 +1079,29 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	}
 
 	uint32 crc32_wait = s->cur_file_info.crc;
+	uint32 dataOffset = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar;
+
+	// Big members are streamed from the archive instead of being loaded into
+	// memory at once, and are not kept in the member cache either. Deflated
+	// ones are read through a seekable inflate stream which keeps checkpoints,
+	// so seeking back does not restart decompression from the start of the
+	// member. Without checkpoints they are still inflated in one go.
+	bool streamMember = (s->cur_file_info.uncompressed_size > UNZ_MAX_IN_MEMORY_SIZE);
+#ifndef UNZ_STREAM_DEFLATED_MEMBERS
+	if (s->cur_file_info.compression_method == Z_DEFLATED)
+		streamMember = false;
+#endif
+	if (streamMember) {
+		Common::SeekableReadStream *member = new UnzMemberReadStream(s->_streamRef, dataOffset, dataOffset + s->cur_file_info.compressed_size);
+		if (s->cur_file_info.compression_method == Z_DEFLATED)
+			member = Common::wrapDeflateReadStream(member, DisposeAfterUse::YES, s->cur_file_info.uncompressed_size);
+		if (!member)
+			return Common::SharedArchiveContents();
+		return Common::SharedArchiveContents::bypass(new UnzCrcCheckingReadStream(member, crc32_wait));
+	}
 
 	byte *compressedBuffer = new byte[s->cur_file_info.compressed_size];
-	s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
+	s->_stream->seek(dataOffset);
 	s->_stream->read(compressedBuffer, s->cur_file_info.compressed_size);
 	byte *uncompressedBuffer = nullptr;
 
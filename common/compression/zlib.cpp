@@ -33,6 +33,7 @@
 
 #include "common/compression/deflate.h"
 
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -89,15 +90,36 @@ bool inflateZlibHeaderless(byte *dst, uint *dstLen, const byte *src, uint srcLen
 static bool _shownBackwardSeekingWarning = false;
 #endif
 
+// inflateGetDictionary() is needed to snapshot the inflate window
+#if ZLIB_VERNUM >= 0x1271
+#define GZIP_USE_CHECKPOINTS
+#endif
+
 /**
  * A simple wrapper class which can be used to wrap around an arbitrary
  * other SeekableReadStream and will then provide on-the-fly decompression support.
  * Assumes the compressed data to be in gzip format.
+ *
+ * While decompressing for the first time, the stream records a checkpoint
+ * (the position in both streams and a copy of the inflate window) at the
+ * first deflate block boundary after every CHECKPOINT_INTERVAL bytes of
+ * output, in the same way as zlib's zran example. Seeks then resume
+ * decompression from the closest checkpoint instead of the start of the data.
  */
 class GZipReadStream : public SeekableReadStream {
 protected:
 	enum {
-		BUFSIZE = 16384		// 1 << MAX_WBITS
+		BUFSIZE = 16384,		// 1 << MAX_WBITS
+		WINDOWSIZE = 32768,
+		CHECKPOINT_INTERVAL = 1024 * 1024
+	};
+
+	struct Checkpoint {
+		uint32 outPos;	// Position in the decompressed data
+		uint64 inPos;	// Position of the next compressed byte, relative to _parentPos
+		int bits;		// Number of bits of the byte before inPos not yet consumed
+		uint windowSize;
+		byte *window;
 	};
 
 	byte	_buf[BUFSIZE];
@@ -105,10 +127,72 @@ protected:
 	DisposablePtr<SeekableReadStream> _wrapped;
 	z_stream _stream;
 	int _zlibErr;
+	int _windowBits;
 	uint64 _parentPos;
 	uint32 _pos;
 	uint32 _origSize;
 	bool _eos;
+	Array<Checkpoint> _checkpoints;
+
+#ifdef GZIP_USE_CHECKPOINTS
+	uint32 nextCheckpointPos() const {
+		return (_checkpoints.empty() ? 0 : _checkpoints.back().outPos) + CHECKPOINT_INTERVAL;
+	}
+
+	void addCheckpoint(uint32 outPos) {
+		Checkpoint checkpoint;
+		checkpoint.outPos = outPos;
+		checkpoint.inPos = _wrapped->pos() - _parentPos - _stream.avail_in;
+		checkpoint.bits = _stream.data_type & 7;
+		checkpoint.window = new byte[WINDOWSIZE];
+
+		uInt windowSize = WINDOWSIZE;
+		if (inflateGetDictionary(&_stream, checkpoint.window, &windowSize) != Z_OK) {
+			delete[] checkpoint.window;
+			return;
+		}
+		checkpoint.windowSize = windowSize;
+
+		_checkpoints.push_back(checkpoint);
+	}
+
+	bool restoreCheckpoint(const Checkpoint &checkpoint) {
+		// Checkpoints are always inside the raw deflate data
+		_zlibErr = inflateReset2(&_stream, -MAX_WBITS);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_wrapped->seek(_parentPos + checkpoint.inPos - (checkpoint.bits ? 1 : 0), SEEK_SET);
+		if (checkpoint.bits) {
+			byte partial = _wrapped->readByte();
+			_zlibErr = inflatePrime(&_stream, checkpoint.bits, partial >> (8 - checkpoint.bits));
+			if (_zlibErr != Z_OK)
+				return false;
+		}
+
+		_zlibErr = inflateSetDictionary(&_stream, checkpoint.window, checkpoint.windowSize);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		_pos = checkpoint.outPos;
+		return true;
+	}
+#endif
+
+	/** Return the last checkpoint at or before the given position, if any. */
+	const Checkpoint *findCheckpoint(uint32 pos) const {
+		uint lo = 0, hi = _checkpoints.size();
+		while (lo < hi) {
+			uint mid = (lo + hi) / 2;
+			if (_checkpoints[mid].outPos <= pos)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo ? &_checkpoints[lo - 1] : nullptr;
+	}
 
 public:
 
@@ -139,7 +223,8 @@ public:
 		// the compressed file. This feature was added in zlib 1.2.0.4,
 		// released 10 August 2003.
 		// Note: This is *crucial* for savegame compatibility, do *not* remove!
-		_zlibErr = inflateInit2(&_stream, MAX_WBITS + 32);
+		_windowBits = MAX_WBITS + 32;
+		_zlibErr = inflateInit2(&_stream, _windowBits);
 		if (_zlibErr != Z_OK)
 			return;
 
@@ -159,7 +244,8 @@ public:
 		_pos = 0;
 		_eos = false;
 
-		_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
+		_windowBits = -MAX_WBITS;
+		_zlibErr = inflateInit2(&_stream, _windowBits);
 		if (_zlibErr != Z_OK)
 			return;
 
@@ -177,6 +263,9 @@ public:
 
 	~GZipReadStream() {
 		inflateEnd(&_stream);
+
+		for (auto &checkpoint : _checkpoints)
+			delete[] checkpoint.window;
 	}
 
 	bool err() const override { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
@@ -196,6 +285,16 @@ public:
 				_stream.next_in = _buf;
 				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
 			}
+#ifdef GZIP_USE_CHECKPOINTS
+			uint32 outPos = _pos + dataSize - _stream.avail_out;
+			if (outPos >= nextCheckpointPos()) {
+				// Stop at the next block boundary and record a checkpoint there
+				_zlibErr = inflate(&_stream, Z_BLOCK);
+				if (_zlibErr == Z_OK && (_stream.data_type & 128) && !(_stream.data_type & 64))
+					addCheckpoint(_pos + dataSize - _stream.avail_out);
+				continue;
+			}
+#endif
 			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
 		}
 
@@ -236,6 +335,14 @@ public:
 
 		assert(newPos >= 0);
 
+#ifdef GZIP_USE_CHECKPOINTS
+		// Resume from a checkpoint when it avoids decompressing data again
+		const Checkpoint *checkpoint = findCheckpoint(newPos);
+		if (checkpoint && ((uint32)newPos < _pos || checkpoint->outPos > _pos)) {
+			if (!restoreCheckpoint(*checkpoint))
+				return false; // FIXME: STREAM REWRITE
+		} else
+#endif
 		if ((uint32)newPos < _pos) {
 			// To search backward, we have to restart the whole decompression
 			// from the start of the file. A rather wasteful operation, best
@@ -253,7 +360,12 @@ public:
 
 			_pos = 0;
 			_wrapped->seek(_parentPos, SEEK_SET);
+#ifdef GZIP_USE_CHECKPOINTS
+			// A checkpoint may have switched the stream to raw deflate
+			_zlibErr = inflateReset2(&_stream, _windowBits);
+#else
 			_zlibErr = inflateReset(&_stream);
+#endif
 			if (_zlibErr != Z_OK)
 				return false; // FIXME: STREAM REWRITE
 			_stream.next_in = _buf;
@@ -252,6 +252,20 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Query the size and last modification time of the file referred by
+	 * this node without opening it.
+	 *
+	 * The modification time is only meaningful when compared with another
+	 * value returned for the same file by the same backend.
+	 *
+	 * @param size  Receives the file size in bytes.
+	 * @param mtime Receives the modification time.
+	 *
+	 * @return True if the backend provided the information, false otherwise.
+	 */
+	bool getFileStat(int64 &size, int64 &mtime) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
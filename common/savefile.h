@@ -276,6 +276,21 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Query the size and last modification time of a save file without
+	 * opening it. This allows to check cheaply whether a save file changed.
+	 *
+	 * The modification time is only meaningful when compared with another
+	 * value returned for the same file.
+	 *
+	 * @param name  Name of the save file.
+	 * @param size  Receives the size of the file as stored.
+	 * @param mtime Receives the modification time.
+	 *
+	 * @return true if the information is available. false otherwise.
+	 */
+	virtual bool getSavefileStat(const String &name, int64 &size, int64 &mtime) { return false; }
 };
 
 /** @} */
@@ -448,8 +448,9 @@ void AdvancedMetaEngineDetectionBase::composeFileHashMap(FileMap &allFiles, cons
 			if (!_globsMap.contains(efname))
 				continue;
 
+			// Every detector walks the same subdirectories, so share the listings
 			Common::FSList files;
-			if (!file.getChildren(files, Common::FSNode::kListAll))
+			if (!ADCacheMan.getChildren(file, files))
 				continue;
 
 			composeFileHashMap(allFiles, files, depth - 1, tstr);
@@ -475,6 +476,199 @@ namespace Common {
 	DECLARE_SINGLETON(AdvancedDetectorCacheManager);
 }
 
+/* Persistent MD5 cache, kept next to the configuration file */
+
+enum {
+	kPersistentCacheVersion = 2,
+	// Minimum delay between two non-forced writes of the cache file
+	kPersistentCacheFlushDelay = 10000,
+	// Maximum number of entries kept in the cache file
+	kPersistentCacheMaxEntries = 20000
+};
+
+static bool md5StringToBytes(const Common::String &md5, byte *bytes) {
+	if (md5.size() != 32)
+		return false;
+
+	for (int i = 0; i < 32; i++) {
+		char c = md5[i];
+		byte nibble;
+
+		if (c >= '0' && c <= '9')
+			nibble = c - '0';
+		else if (c >= 'a' && c <= 'f')
+			nibble = c - 'a' + 10;
+		else
+			return false;
+
+		if (i & 1)
+			bytes[i >> 1] |= nibble;
+		else
+			bytes[i >> 1] = nibble << 4;
+	}
+
+	return true;
+}
+
+static Common::String md5BytesToString(const byte *bytes) {
+	Common::String res;
+
+	for (int i = 0; i < 16; i++)
+		res += Common::String::format("%02x", bytes[i]);
+
+	return res;
+}
+
+Common::Path AdvancedDetectorCacheManager::getPersistentCachePath() const {
+	Common::Path configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+
+	return configFile.getParent().appendComponent("detection-md5.cache");
+}
+
+void AdvancedDetectorCacheManager::loadPersistentCache() {
+	persistentLoaded = true;
+
+	Common::FSNode node(getPersistentCachePath());
+	Common::ScopedPtr<Common::SeekableReadStream> stream(node.createReadStream());
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() != MKTAG('A', 'D', 'M', 'C') || stream->readUint32LE() != kPersistentCacheVersion) {
+		debugC(3, kDebugGlobalDetection, "Ignoring MD5 cache file with unknown format");
+		return;
+	}
+
+	// Each run which loads the cache counts as a new session
+	persistentSession = stream->readUint32LE() + 1;
+	uint32 count = stream->readUint32LE();
+
+	for (uint32 i = 0; i < count; i++) {
+		uint16 keyLen = stream->readUint16LE();
+		Common::String key = stream->readString(0, keyLen);
+
+		PersistentEntry entry;
+		entry.fileSize = stream->readSint64LE();
+		entry.mtime = stream->readSint64LE();
+		entry.size = stream->readSint64LE();
+		stream->read(entry.md5, sizeof(entry.md5));
+		entry.lastUsed = stream->readUint32LE();
+
+		if (stream->err() || stream->eos()) {
+			warning("Truncated MD5 cache file, discarding it");
+			persistentHashMap.clear();
+			return;
+		}
+
+		persistentHashMap.setVal(key, entry);
+	}
+
+	debugC(3, kDebugGlobalDetection, "Loaded %d entries from the MD5 cache", persistentHashMap.size());
+}
+
+bool AdvancedDetectorCacheManager::getPersistentMD5(const Common::String &key, int64 fileSize, int64 mtime, Common::String &md5, int64 &size) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	PersistentHashMap::iterator it = persistentHashMap.find(key);
+	if (it == persistentHashMap.end())
+		return false;
+
+	PersistentEntry &entry = it->_value;
+	if (entry.fileSize != fileSize || entry.mtime != mtime)
+		return false;
+
+	if (entry.lastUsed != persistentSession) {
+		entry.lastUsed = persistentSession;
+		persistentDirty = true;
+	}
+
+	md5 = md5BytesToString(entry.md5);
+	size = entry.size;
+	return true;
+}
+
+void AdvancedDetectorCacheManager::setPersistentMD5(const Common::String &key, int64 fileSize, int64 mtime, const Common::String &md5, int64 size) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	PersistentEntry entry;
+	if (!md5StringToBytes(md5, entry.md5))
+		return;
+
+	entry.fileSize = fileSize;
+	entry.mtime = mtime;
+	entry.size = size;
+	entry.lastUsed = persistentSession;
+
+	persistentHashMap.setVal(key, entry);
+	persistentDirty = true;
+}
+
+void AdvancedDetectorCacheManager::flushPersistentCache(bool force) {
+	if (!persistentDirty)
+		return;
+
+	uint32 now = g_system->getMillis();
+	if (!force && persistentFlushed && now - persistentLastFlush < kPersistentCacheFlushDelay)
+		return;
+
+	evictPersistentEntries();
+
+	Common::FSNode node(getPersistentCachePath());
+	Common::ScopedPtr<Common::WriteStream> stream(node.createWriteStream());
+	if (!stream) {
+		warning("Unable to write MD5 cache file '%s'", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		persistentDirty = false;
+		return;
+	}
+
+	stream->writeUint32BE(MKTAG('A', 'D', 'M', 'C'));
+	stream->writeUint32LE(kPersistentCacheVersion);
+	stream->writeUint32LE(persistentSession);
+	stream->writeUint32LE(persistentHashMap.size());
+
+	for (const auto &entry : persistentHashMap) {
+		stream->writeUint16LE(entry._key.size());
+		stream->writeString(entry._key);
+		stream->writeSint64LE(entry._value.fileSize);
+		stream->writeSint64LE(entry._value.mtime);
+		stream->writeSint64LE(entry._value.size);
+		stream->write(entry._value.md5, sizeof(entry._value.md5));
+		stream->writeUint32LE(entry._value.lastUsed);
+	}
+
+	stream->finalize();
+
+	persistentDirty = false;
+	persistentFlushed = true;
+	persistentLastFlush = now;
+}
+
+static bool lastUsedLess(const Common::Pair<uint32, Common::String> &a, const Common::Pair<uint32, Common::String> &b) {
+	return a.first < b.first;
+}
+
+void AdvancedDetectorCacheManager::evictPersistentEntries() {
+	if (persistentHashMap.size() <= kPersistentCacheMaxEntries)
+		return;
+
+	// Sort the keys from the least to the most recently used
+	Common::Array<Common::Pair<uint32, Common::String> > keys;
+	keys.reserve(persistentHashMap.size());
+	for (const auto &entry : persistentHashMap)
+		keys.push_back(Common::Pair<uint32, Common::String>(entry._value.lastUsed, entry._key));
+
+	Common::sort(keys.begin(), keys.end(), lastUsedLess);
+
+	const uint excess = keys.size() - kPersistentCacheMaxEntries;
+	for (uint i = 0; i < excess; i++)
+		persistentHashMap.erase(keys[i].second);
+
+	debugC(3, kDebugGlobalDetection, "Dropped %u least recently used entries from the MD5 cache", excess);
+}
+
 
 static MD5Properties gameFileToMD5Props(const ADGameFileDescription *fileEntry, uint32 gameFlags) {
 	MD5Properties ret = kMD5Head;
@@ -548,11 +742,50 @@ bool AdvancedMetaEngineDetectionBase::getFileProperties(const FileMap &allFiles,
 		return true;
 	}
 
+	// Hashes of plain files and of files inside archives only depend on a
+	// single file on disk, so they can be kept across runs as long as that
+	// file is unchanged. Resource forks may live in several sidecar files
+	// and are always recomputed.
+	Common::String persistentKey;
+	int64 fileSize = 0, mtime = 0;
+
+	if (!(md5prop & (kMD5MacResFork | kMD5MacDataFork))) {
+		Common::Path diskName = fname;
+		if (md5prop & kMD5Archive) {
+			Common::StringTokenizer tok(fname.toString(), ":");
+			tok.nextToken();
+			diskName = Common::Path(tok.nextToken());
+		}
+
+		if (allFiles.contains(diskName)) {
+			const Common::FSNode &node = allFiles[diskName];
+			if (node.getFileStat(fileSize, mtime)) {
+				persistentKey = md5PropToCachePrefix(md5prop);
+				persistentKey += ':';
+				persistentKey += node.getPath().toString('/');
+				persistentKey += ':';
+				persistentKey += fname.toString('/');
+				persistentKey += ':';
+				persistentKey += Common::String::format("%d", _md5Bytes);
+			}
+		}
+	}
+
+	if (!persistentKey.empty() && ADCacheMan.getPersistentMD5(persistentKey, fileSize, mtime, fileProps.md5, fileProps.size)) {
+		fileProps.md5prop = (MD5Properties)(md5prop & kMD5Tail);
+		ADCacheMan.setMD5(hashname, fileProps.md5);
+		ADCacheMan.setSize(hashname, fileProps.size);
+		return true;
+	}
+
 	bool res = getFilePropertiesIntern(_md5Bytes, allFiles, md5prop, fname, fileProps);
 
 	if (res) {
 		ADCacheMan.setMD5(hashname, fileProps.md5);
 		ADCacheMan.setSize(hashname, fileProps.size);
+
+		if (!persistentKey.empty())
+			ADCacheMan.setPersistentMD5(persistentKey, fileSize, mtime, fileProps.md5, fileProps.size);
 	}
 
 	return res;
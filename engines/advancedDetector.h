@@ -778,10 +778,55 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
-	AdvancedDetectorCacheManager() {
+	/**
+	 * List the contents of a directory, reusing the listing made by a
+	 * previous detector during the same detection run.
+	 */
+	bool getChildren(const Common::FSNode &node, Common::FSList &list) {
+		DirectoryHashMap::const_iterator it = directoryHashMap.find(node.getPath());
+		if (it != directoryHashMap.end()) {
+			list = it->_value;
+			return true;
+		}
+
+		if (!node.getChildren(list, Common::FSNode::kListAll))
+			return false;
+
+		directoryHashMap.setVal(node.getPath(), list);
+		return true;
+	}
+
+	/**
+	 * Look up a hash in the persistent cache.
+	 *
+	 * Entries are only returned when the size and modification time of the
+	 * file on disk still match the ones recorded with the hash.
+	 */
+	bool getPersistentMD5(const Common::String &key, int64 fileSize, int64 mtime, Common::String &md5, int64 &size);
+
+	/** Record a hash in the persistent cache. */
+	void setPersistentMD5(const Common::String &key, int64 fileSize, int64 mtime, const Common::String &md5, int64 size);
+
+	/**
+	 * Write the persistent cache to disk if it changed.
+	 *
+	 * Unless @p force is set, writes are rate limited so that scanning many
+	 * directories in a row does not rewrite the whole file every time.
+	 *
+	 * Only the most recently used entries are kept, so that hashes of game
+	 * files which were moved or deleted eventually get dropped.
+	 */
+	void flushPersistentCache(bool force = true);
+
+	AdvancedDetectorCacheManager() : persistentLoaded(false), persistentSession(0), persistentDirty(false), persistentFlushed(false), persistentLastFlush(0) {
 		clear();
 	}
 
+	~AdvancedDetectorCacheManager() {
+		flushPersistentCache();
+		clearArchives();
+	}
+
 	void clearArchives() {
 		for (auto &entry : archiveHashMap) {
 			delete entry._value;
@@ -792,6 +837,7 @@ public:
 	void clear() {
 		md5HashMap.clear(true);
 		sizeHashMap.clear(true);
+		directoryHashMap.clear(true);
 		clearArchives();
 	}
 
@@ -801,9 +847,31 @@ private:
 	typedef Common::HashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileHashMap;
 	typedef Common::HashMap<Common::String, int64, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SizeHashMap;
 	typedef Common::HashMap<Common::Path, Common::Archive *, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> ArchiveHashMap;
+	typedef Common::HashMap<Common::Path, Common::FSList, Common::Path::Hash, Common::Path::EqualTo> DirectoryHashMap;
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+	DirectoryHashMap directoryHashMap;
+
+	struct PersistentEntry {
+		int64 fileSize;
+		int64 mtime;
+		int64 size;
+		byte md5[16];
+		uint32 lastUsed;             // Session in which the entry was last used
+	};
+
+	typedef Common::HashMap<Common::String, PersistentEntry> PersistentHashMap;
+	PersistentHashMap persistentHashMap;
+	bool persistentLoaded;
+	uint32 persistentSession;
+	bool persistentDirty;
+	bool persistentFlushed;
+	uint32 persistentLastFlush;
+
+	Common::Path getPersistentCachePath() const;
+	void loadPersistentCache();
+	void evictPersistentEntries();
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
@@ -0,0 +1,86 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ags/shared/core/platform.h"
+#include "ags/shared/script/cc_internal.h"
+#include "ags/shared/script/cc_script.h"
+#include "ags/shared/util/string_compat.h"
+#include "ags/engine/script/cc_instance.h"
+#include "ags/globals.h"
+#include "common/scummsys.h"
+#include "common/debug.h"
+
+namespace AGS3 {
+
+// Creates a script with a single exported function "sum",
+// which returns the sum of all numbers below the given limit
+static PScript Test_CreateSumScript(int32_t limit) {
+	const int32_t code[] = {
+		SCMD_LITTOREG, SREG_BX, 0,          // 0: bx = 0 (sum)
+		SCMD_LITTOREG, SREG_CX, 0,          // 3: cx = 0 (counter)
+		SCMD_LITTOREG, SREG_DX, limit,      // 6: dx = limit
+		SCMD_ADDREG, SREG_BX, SREG_CX,      // 9: bx += cx
+		SCMD_ADD, SREG_CX, 1,               // 12: cx += 1
+		SCMD_REGTOREG, SREG_CX, SREG_AX,    // 15: ax = cx
+		SCMD_LESSTHAN, SREG_AX, SREG_DX,    // 18: ax = ax < dx
+		SCMD_JNZ, -14,                      // 21: if (ax) goto 9
+		SCMD_REGTOREG, SREG_BX, SREG_AX,    // 23: ax = bx
+		SCMD_RET                            // 26: return ax
+	};
+
+	PScript scri(new ccScript());
+	scri->codesize = ARRAYSIZE(code);
+	scri->code = static_cast<int32_t *>(malloc(sizeof(code)));
+	memcpy(scri->code, code, sizeof(code));
+	scri->imports = static_cast<char **>(malloc(sizeof(char *)));
+	scri->exports = static_cast<char **>(malloc(sizeof(char *)));
+	scri->export_addr = static_cast<int32_t *>(malloc(sizeof(int32_t)));
+	scri->exports[0] = ags_strdup("sum$0");
+	scri->export_addr[0] = EXPORT_FUNCTION << 24;
+	scri->numexports = 1;
+	return scri;
+}
+
+void Test_Script() {
+	// The script sums in 32 bits, so the sum of 0 .. limit - 1 must fit in an
+	// int32_t: 65536 is the largest limit for which it does
+	const int32_t limits[] = {1, 2, 1000, 10000, 65536};
+	uint32 time = 0;
+	uint64 numIters = 0;
+
+	for (size_t i = 0; i < ARRAYSIZE(limits); i++) {
+		std::unique_ptr<ccInstance> inst = ccInstance::CreateFromScript(Test_CreateSumScript(limits[i]));
+		assert(inst);
+
+		const uint32 start = std::chrono::high_resolution_clock::now();
+		const int ret = inst->CallScriptFunction("sum", 0, nullptr);
+		const uint32 end = std::chrono::high_resolution_clock::now();
+		assert(ret == 0);
+		assert(inst->returnValue == (int32_t)((int64)limits[i] * (limits[i] - 1) / 2));
+
+		time += end - start;
+		numIters += limits[i];
+	}
+
+	debug("Script interpreter: %u millis for %u loop iterations (6 instructions each).", time, (uint)numIters);
+}
+
+} // namespace AGS3
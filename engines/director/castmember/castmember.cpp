@@ -97,14 +97,14 @@ Common::Rect CastMember::getBbox(int16 currentWidth, int16 currentHeight) {
 }
 
 bool CastMember::hasProp(const Common::String &propName) {
-	Common::String fieldName = Common::String::format("%d%s", kTheCast, propName.c_str());
-	return g_lingo->_theEntityFields.contains(fieldName) && hasField(g_lingo->_theEntityFields[fieldName]->field);
+	const TheEntityField *field = g_lingo->lookupTheField(kTheCast, propName);
+	return field && hasField(field->field);
 }
 
 Datum CastMember::getProp(const Common::String &propName) {
-	Common::String fieldName = Common::String::format("%d%s", kTheCast, propName.c_str());
-	if (g_lingo->_theEntityFields.contains(fieldName)) {
-		return getField(g_lingo->_theEntityFields[fieldName]->field);
+	const TheEntityField *field = g_lingo->lookupTheField(kTheCast, propName);
+	if (field) {
+		return getField(field->field);
 	}
 
 	warning("CastMember::getProp: unknown property '%s'", propName.c_str());
@@ -112,9 +112,9 @@ Datum CastMember::getProp(const Common::String &propName) {
 }
 
 bool CastMember::setProp(const Common::String &propName, const Datum &value, bool force) {
-	Common::String fieldName = Common::String::format("%d%s", kTheCast, propName.c_str());
-	if (g_lingo->_theEntityFields.contains(fieldName)) {
-		return setField(g_lingo->_theEntityFields[fieldName]->field, value);
+	const TheEntityField *field = g_lingo->lookupTheField(kTheCast, propName);
+	if (field) {
+		return setField(field->field, value);
 	}
 
 	warning("CastMember::setProp: unknown property '%s'", propName.c_str());
@@ -701,6 +701,93 @@ void DirectorPlotData::inkBlitShape(Common::Rect &srcRect) {
 	}
 }
 
+enum InkRowOp {
+	kInkRowCopy,
+	kInkRowBackgndTrans,
+	kInkRowBlend
+};
+
+// Row blitters for the most common inks, specialized per ink and pixel size
+// so that the inner loops have no per-pixel dispatch. They must give the
+// same result as InkPrimitives<T>::drawPoint for the cases inkBlitRowsFor()
+// picks them for, which Window::testInkBlitRows() checks.
+template <typename T, InkRowOp OP, bool MASKED>
+static void inkBlitRowsSpecialized(DirectorPlotData *p, const Graphics::Surface *mask, const Common::Point &srcOrigin) {
+	Graphics::MacWindowManager *wm = p->d->_wm;
+	const uint32 backColor = p->backColor;
+	const int alpha = p->alpha;
+	const int width = p->destRect.width();
+
+	for (int i = 0; i < p->destRect.height(); i++) {
+		T *dst = (T *)p->dst->getBasePtr(p->destRect.left, p->destRect.top + i);
+		const T *src = (const T *)p->srf->getBasePtr(srcOrigin.x, srcOrigin.y + i);
+		const byte *msk = MASKED ? (const byte *)mask->getBasePtr(srcOrigin.x, srcOrigin.y + i) : nullptr;
+
+		for (int j = 0; j < width; j++) {
+			if (MASKED && !msk[j])
+				continue;
+
+			switch (OP) {
+			case kInkRowCopy:
+				dst[j] = src[j];
+				break;
+			case kInkRowBackgndTrans:
+				if (src[j] != backColor)
+					dst[j] = src[j];
+				break;
+			case kInkRowBlend: {
+				byte rSrc, gSrc, bSrc;
+				byte rDst, gDst, bDst;
+
+				wm->decomposeColor<T>(src[j], rSrc, gSrc, bSrc);
+				wm->decomposeColor<T>(dst[j], rDst, gDst, bDst);
+
+				rDst = lerpByte(rSrc, rDst, alpha, 255);
+				gDst = lerpByte(gSrc, gDst, alpha, 255);
+				bDst = lerpByte(bSrc, bDst, alpha, 255);
+				dst[j] = wm->findBestColor(rDst, gDst, bDst);
+				break;
+			}
+			}
+		}
+	}
+}
+
+template <typename T, InkRowOp OP>
+static void inkBlitRowsMasked(DirectorPlotData *p, const Graphics::Surface *mask, const Common::Point &srcOrigin) {
+	if (mask)
+		inkBlitRowsSpecialized<T, OP, true>(p, mask, srcOrigin);
+	else
+		inkBlitRowsSpecialized<T, OP, false>(p, mask, srcOrigin);
+}
+
+template <typename T>
+static bool inkBlitRowsFor(DirectorPlotData *p, const Graphics::Surface *mask, const Common::Point &srcOrigin) {
+	// Text sprites get their colors adjusted by preprocessColor(), and
+	// colorized or one-bit images need the full per-pixel treatment
+	if (p->sprite == kTextSprite || p->applyColor || p->oneBitImage)
+		return false;
+
+	if (p->alpha) {
+		inkBlitRowsMasked<T, kInkRowBlend>(p, mask, srcOrigin);
+		return true;
+	}
+
+	switch (p->ink) {
+	case kInkTypeCopy:
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeBlend:
+		inkBlitRowsMasked<T, kInkRowCopy>(p, mask, srcOrigin);
+		return true;
+	case kInkTypeBackgndTrans:
+		inkBlitRowsMasked<T, kInkRowBackgndTrans>(p, mask, srcOrigin);
+		return true;
+	default:
+		return false;
+	}
+}
+
 void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask) {
 	if (!srf)
 		return;
@@ -710,7 +797,6 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 		applyColor = false;
 
 	Common::Rect srfClip = srf->getBounds();
-	bool failedBoundsCheck = false;
 
 	// FAST PATH: if we're not doing any per-pixel ops,
 	// use the stock blitter. Your CPU will thank you.
@@ -734,6 +820,33 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	// For blit efficiency, surfaces passed here need to be the same
 	// format as the window manager. Most of the time this is
 	// the job of BitmapCastMember::createWidget.
+	if (!ms && inkBlitSurfaceRows(srcRect, mask))
+		return;
+
+	inkBlitSurfacePixels(srcRect, mask);
+}
+
+bool DirectorPlotData::inkBlitSurfaceRows(Common::Rect &srcRect, const Graphics::Surface *mask) {
+	// Common inks on sprites that lie entirely within their surface
+	// are drawn a row at a time
+	const Common::Point srcOrigin(abs(srcRect.left - destRect.left), abs(srcRect.top - destRect.top));
+	if (!srf->getBounds().contains(Common::Rect(srcOrigin.x, srcOrigin.y, srcOrigin.x + destRect.width(), srcOrigin.y + destRect.height())))
+		return false;
+
+	bool handled;
+	if (d->_wm->_pixelformat.bytesPerPixel == 1)
+		handled = inkBlitRowsFor<byte>(this, mask, srcOrigin);
+	else
+		handled = inkBlitRowsFor<uint32>(this, mask, srcOrigin);
+
+	if (handled)
+		srcPoint = Common::Point(srcOrigin.x + destRect.width(), srcOrigin.y + destRect.height());
+	return handled;
+}
+
+void DirectorPlotData::inkBlitSurfacePixels(Common::Rect &srcRect, const Graphics::Surface *mask) {
+	Common::Rect srfClip = srf->getBounds();
+	bool failedBoundsCheck = false;
 
 	Graphics::Primitives *primitives = g_director->getInkPrimitives();
 
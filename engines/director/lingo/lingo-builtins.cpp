@@ -308,12 +308,15 @@ void Lingo::initBuiltIns(const BuiltinProto protos[]) {
 			break;
 		}
 	}
+
+	invalidateHandlerCache();
 }
 
 void Lingo::cleanupBuiltIns() {
 	_builtinCmds.clear();
 	_builtinFuncs.clear();
 	_builtinConsts.clear();
+	invalidateHandlerCache();
 }
 
 void Lingo::cleanupBuiltIns(const BuiltinProto protos[]) {
@@ -335,6 +338,8 @@ void Lingo::cleanupBuiltIns(const BuiltinProto protos[]) {
 			break;
 		}
 	}
+
+	invalidateHandlerCache();
 }
 
 void Lingo::printArgs(const char *funcname, int nargs, const char *prefix) {
@@ -1679,11 +1679,15 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 	if (!_assemblyContext->isFactory()) {
 		// Register this context's functions with the containing archive.
 		if (scriptType == kScoreScript || scriptType == kMovieScript) {
+			bool added = false;
 			for (auto &it : _assemblyContext->_functionHandlers) {
 				if (!_assemblyArchive->functionHandlers.contains(it._key)) {
 					_assemblyArchive->functionHandlers[it._key] = it._value;
+					added = true;
 				}
 			}
+			if (added)
+				Lingo::invalidateHandlerCache();
 		}
 	}
 
@@ -1656,36 +1656,25 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 	}
 
 	// Handler
-	funcSym = g_lingo->getHandler(name);
+	const HandlerCacheEntry &cached = g_lingo->lookupHandler(name, allowRetVal);
+	funcSym = cached.handler;
+	const TheEntity *theEntity = cached.theEntity;
 
-	if (g_lingo->_builtinListHandlers.contains(name) && nargs >= 1) {
+	if (cached.listHandler.type != VOIDSYM && nargs >= 1) {
 		// Lingo builtin functions in the "List" category have very strange override mechanics.
 		// If the first argument is an ARRAY or PARRAY, it will use the builtin.
 		// Otherwise, it will fall back to whatever handler is defined globally.
 		Datum firstArg = g_lingo->peek(nargs - 1);
 		if (firstArg.type == ARRAY || firstArg.type == PARRAY ||
 				firstArg.type == POINT || firstArg.type == RECT) {
-			funcSym = g_lingo->_builtinListHandlers[name];
-		}
-	}
-
-	if (funcSym.type == VOIDSYM) { // The built-ins could be overridden
-		// Builtin
-		if (allowRetVal) {
-			if (g_lingo->_builtinFuncs.contains(name)) {
-				funcSym = g_lingo->_builtinFuncs[name];
-			}
-		} else {
-			if (g_lingo->_builtinCmds.contains(name)) {
-				funcSym = g_lingo->_builtinCmds[name];
-			}
+			funcSym = cached.listHandler;
 		}
 	}
 
 	// use lingo-the as fallback. we can only use functions as fallback, not properties
-	if (funcSym.type == VOIDSYM && g_lingo->_theEntities.contains(name) && g_lingo->_theEntities[name]->isFunction) {
+	if (funcSym.type == VOIDSYM && theEntity) {
 		Datum id;
-		Datum res = g_lingo->getTheEntity(g_lingo->_theEntities[name]->entity, id, kTheNOField);
+		Datum res = g_lingo->getTheEntity(theEntity->entity, id, kTheNOField);
 		g_lingo->push(res);
 		return;
 	}
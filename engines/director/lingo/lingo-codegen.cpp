@@ -248,11 +248,15 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 
 	// Register this context's functions with the containing archive.
 	if (_assemblyArchive) {
+		bool added = false;
 		for (auto &it : _assemblyContext->_functionHandlers) {
 			if (!_assemblyArchive->functionHandlers.contains(it._key)) {
 				_assemblyArchive->functionHandlers[it._key] = it._value;
+				added = true;
 			}
 		}
+		if (added)
+			Lingo::invalidateHandlerCache();
 	}
 
 	delete _methodVars;
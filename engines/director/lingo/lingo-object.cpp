@@ -733,14 +733,14 @@ Common::String Window::asString() {
 }
 
 bool Window::hasProp(const Common::String &propName) {
-	Common::String fieldName = Common::String::format("%d%s", kTheWindow, propName.c_str());
-	return g_lingo->_theEntityFields.contains(fieldName) && hasField(g_lingo->_theEntityFields[fieldName]->field);
+	const TheEntityField *field = g_lingo->lookupTheField(kTheWindow, propName);
+	return field && hasField(field->field);
 }
 
 Datum Window::getProp(const Common::String &propName) {
-	Common::String fieldName = Common::String::format("%d%s", kTheWindow, propName.c_str());
-	if (g_lingo->_theEntityFields.contains(fieldName)) {
-		return getField(g_lingo->_theEntityFields[fieldName]->field);
+	const TheEntityField *field = g_lingo->lookupTheField(kTheWindow, propName);
+	if (field) {
+		return getField(field->field);
 	}
 
 	warning("Window::getProp: unknown property '%s'", propName.c_str());
@@ -748,9 +748,9 @@ Datum Window::getProp(const Common::String &propName) {
 }
 
 bool Window::setProp(const Common::String &propName, const Datum &value, bool force) {
-	Common::String fieldName = Common::String::format("%d%s", kTheWindow, propName.c_str());
-	if (g_lingo->_theEntityFields.contains(fieldName)) {
-		return setField(g_lingo->_theEntityFields[fieldName]->field, value);
+	const TheEntityField *field = g_lingo->lookupTheField(kTheWindow, propName);
+	if (field) {
+		return setField(field->field, value);
 	}
 
 	warning("Window::setProp: unknown property '%s'", propName.c_str());
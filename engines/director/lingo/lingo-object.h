@@ -223,6 +223,9 @@ public:
 	Common::HashMap<uint32, Datum> _objArray;
 	MethodHash _methodNames;
 	Common::SharedPtr<Node> _assemblyAST;	// Optionally contains AST when we compile Lingo
+	HandlerCache _handlerCache;		// handlers called from this context, see Lingo::lookupHandler()
+	uint32 _handlerCacheGeneration = 0;
+	TheFieldCache _theFieldCache;	// 'the' fields used in this context, see Lingo::lookupTheField()
 
 private:
 	DatumHash _properties;
@@ -2282,6 +2282,24 @@ void Lingo::setTheChunk(Datum &chunk, int field, Datum &d) {
 	((TextCastMember *)member)->setChunkField(field, start, end, d);
 }
 
+const TheEntityField *Lingo::lookupTheField(int entity, const Common::String &propName) {
+	// Property names are fixed in the bytecode, so remember what each
+	// instruction resolved to instead of building and hashing the key again
+	ScriptContext *context = _state ? _state->context : nullptr;
+	const inst *callSite = getCallSite();
+	if (!context || !callSite)
+		return _theEntityFields.getValOrDefault(Common::String::format("%d%s", entity, propName.c_str()), nullptr);
+
+	TheFieldCacheEntry &entry = context->_theFieldCache[callSite];
+	if (entry.entity != entity || entry.name != propName) {
+		entry.entity = entity;
+		entry.name = propName;
+		entry.field = _theEntityFields.getValOrDefault(Common::String::format("%d%s", entity, propName.c_str()), nullptr);
+	}
+
+	return entry.field;
+}
+
 void Lingo::getObjectProp(Datum &obj, Common::String &propName) {
 	Datum d;
 	if (obj.type == OBJECT) {
@@ -2341,11 +2359,11 @@ void Lingo::getObjectProp(Datum &obj, Common::String &propName) {
 			// No matching cast member. Many of the fields are accessible
 			// to indicate the cast member is empty, however the
 			// rest will throw a Lingo error.
-			Common::String key = Common::String::format("%d%s", kTheCast, propName.c_str());
+			const TheEntityField *field = lookupTheField(kTheCast, propName);
 			bool emptyAllowed = false;
-			if (_theEntityFields.contains(key)) {
+			if (field) {
 				emptyAllowed = true;
-				switch (_theEntityFields[key]->field) {
+				switch (field->field) {
 				case kTheCastType:
 				case kTheType:
 					d = Datum("empty");
@@ -2421,16 +2439,16 @@ void Lingo::getObjectProp(Datum &obj, Common::String &propName) {
 		g_lingo->push(d);
 		return;
 	} else if (obj.type == CASTLIBREF) {
-		Common::String key = Common::String::format("%d%s", kTheCastLib, propName.c_str());
-		if (_theEntityFields.contains(key)) {
-			d = getTheCastLib(obj, _theEntityFields[key]->field);
+		const TheEntityField *field = lookupTheField(kTheCastLib, propName);
+		if (field) {
+			d = getTheCastLib(obj, field->field);
 		}
 		g_lingo->push(d);
 		return;
 	} else if (obj.type == SPRITEREF) {
-		Common::String key = Common::String::format("%d%s", kTheSprite, propName.c_str());
-		if (_theEntityFields.contains(key)) {
-			d = getTheSprite(obj, _theEntityFields[key]->field);
+		const TheEntityField *field = lookupTheField(kTheSprite, propName);
+		if (field) {
+			d = getTheSprite(obj, field->field);
 		}
 		g_lingo->push(d);
 		return;
@@ -2496,10 +2514,10 @@ void Lingo::setObjectProp(Datum &obj, Common::String &propName, Datum &val) {
 		CastMemberID id = *obj.u.cast;
 		CastMember *member = movie->getCastMember(id);
 		if (!member) {
-			Common::String key = Common::String::format("%d%s", kTheCast, propName.c_str());
+			const TheEntityField *field = lookupTheField(kTheCast, propName);
 			bool emptyAllowed = false;
-			if (_theEntityFields.contains(key)) {
-				switch (_theEntityFields[key]->field) {
+			if (field) {
+				switch (field->field) {
 				case kTheFileName:
 				case kTheScriptText:
 				case kTheLoaded:
@@ -2542,14 +2560,14 @@ void Lingo::setObjectProp(Datum &obj, Common::String &propName, Datum &val) {
 			g_lingo->lingoError("Lingo::setObjectProp(): %s has no property '%s'", id.asString().c_str(), propName.c_str());
 		}
 	} else if (obj.type == CASTLIBREF) {
-		Common::String key = Common::String::format("%d%s", kTheCastLib, propName.c_str());
-		if (_theEntityFields.contains(key)) {
-			setTheCastLib(obj, _theEntityFields[key]->field, val);
+		const TheEntityField *field = lookupTheField(kTheCastLib, propName);
+		if (field) {
+			setTheCastLib(obj, field->field, val);
 		}
 	} else if (obj.type == SPRITEREF) {
-		Common::String key = Common::String::format("%d%s", kTheSprite, propName.c_str());
-		if (_theEntityFields.contains(key)) {
-			setTheSprite(obj, _theEntityFields[key]->field, val);
+		const TheEntityField *field = lookupTheField(kTheSprite, propName);
+		if (field) {
+			setTheSprite(obj, field->field, val);
 		}
 	} else {
 		g_lingo->lingoError("Lingo::setObjectProp: Invalid object: %s", obj.asString(true).c_str());
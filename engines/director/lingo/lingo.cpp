@@ -210,6 +210,7 @@ Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 	_windowList.u.farr = new FArray;
 
 	_compiler = new LingoCompiler;
+	_handlerCacheGeneration = 0;
 
 	initEventHandlerTypes();
 	initCharNormalizations();
@@ -269,6 +270,8 @@ LingoArchive::~LingoArchive() {
 		}
 		delete it._value;
 	}
+
+	Lingo::invalidateHandlerCache();
 }
 
 ScriptContext *LingoArchive::getScriptContext(ScriptType type, uint16 id) {
@@ -348,6 +351,58 @@ Symbol Lingo::getHandler(const Common::String &name) {
 	return sym;
 }
 
+// Bumped whenever the handlers reachable from every context change: when
+// handlers are registered with, patched in or removed from an archive, or
+// builtins are (un)registered. Freeing a context only drops its own cache.
+static uint32 s_handlerCacheGeneration = 0;
+
+void Lingo::invalidateHandlerCache() {
+	s_handlerCacheGeneration++;
+}
+
+const inst *Lingo::getCallSite() const {
+	if (!_state || !_state->script)
+		return nullptr;
+
+	return _state->script->data() + _state->pc;
+}
+
+const HandlerCacheEntry &Lingo::lookupHandler(const Common::String &name, bool allowRetVal) {
+	ScriptContext *context = _state->context;
+	HandlerCache &cache = context ? context->_handlerCache : _handlerCache;
+	uint32 &generation = context ? context->_handlerCacheGeneration : _handlerCacheGeneration;
+
+	if (generation != s_handlerCacheGeneration) {
+		cache.clear();
+		generation = s_handlerCacheGeneration;
+	}
+
+	Movie *movie = g_director->getCurrentMovie();
+
+	HandlerCacheEntry &entry = cache[getCallSite()];
+	if (entry.name == name && entry.movie == movie && entry.allowRetVal == allowRetVal)
+		return entry;
+
+	entry.name = name;
+	entry.movie = movie;
+	entry.allowRetVal = allowRetVal;
+
+	entry.handler = getHandler(name);
+	if (entry.handler.type == VOIDSYM) { // The built-ins could be overridden
+		const SymbolHash &builtins = allowRetVal ? _builtinFuncs : _builtinCmds;
+		if (builtins.contains(name))
+			entry.handler = builtins.getVal(name);
+	}
+
+	entry.listHandler = _builtinListHandlers.getValOrDefault(name);
+
+	entry.theEntity = nullptr;
+	if (entry.handler.type == VOIDSYM && _theEntities.contains(name) && _theEntities[name]->isFunction)
+		entry.theEntity = _theEntities[name];
+
+	return entry;
+}
+
 
 void LingoArchive::patchCode(const Common::U32String &code, ScriptType type, uint16 id, const char *scriptName, uint32 preprocFlags) {
 	debugC(1, kDebugCompile, "LingoArchive::patchCode: Patching code for type %s(%d) with id %d in '%s%s'\n"
@@ -371,6 +426,8 @@ void LingoArchive::patchCode(const Common::U32String &code, ScriptType type, uin
 		}
 		sc->_functionHandlers.clear();
 		delete sc;
+
+		Lingo::invalidateHandlerCache();
 	}
 }
 
@@ -407,6 +464,7 @@ void LingoArchive::removeCode(ScriptType type, uint16 id) {
 
 	ctx->decRefCount();
 	scriptContexts[type].erase(id);
+	Lingo::invalidateHandlerCache();
 }
 
 void LingoArchive::replaceCode(const Common::U32String &code, ScriptType type, uint16 id, const char *scriptName) {
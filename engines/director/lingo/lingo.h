@@ -47,6 +47,7 @@ class ScriptContext;
 class DirectorEngine;
 class Frame;
 class LingoCompiler;
+class Movie;
 struct Breakpoint;
 
 typedef void (*inst)(void);
@@ -248,6 +249,31 @@ typedef Common::HashMap<Common::String, AbstractObject *, Common::IgnoreCase_Has
 typedef Common::HashMap<Common::String, const TheEntity *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TheEntityHash;
 typedef Common::HashMap<Common::String, const TheEntityField *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TheEntityFieldHash;
 
+// Inline caches, keyed by the position of the calling instruction.
+// Entries live in the calling ScriptContext and go away with it.
+// The name is kept to tell apart scripts reusing the same memory.
+struct HandlerCacheEntry {
+	Common::String name;
+	Movie *movie;
+	bool allowRetVal;
+	Symbol handler;				/* handler or builtin the name resolves to */
+	Symbol listHandler;			/* builtin override for list arguments */
+	const TheEntity *theEntity;	/* 'the' function fallback */
+
+	HandlerCacheEntry() : movie(nullptr), allowRetVal(false), theEntity(nullptr) {}
+};
+
+struct TheFieldCacheEntry {
+	Common::String name;
+	int entity;
+	const TheEntityField *field;
+
+	TheFieldCacheEntry() : entity(-1), field(nullptr) {}
+};
+
+typedef Common::HashMap<const inst *, HandlerCacheEntry> HandlerCache;
+typedef Common::HashMap<const inst *, TheFieldCacheEntry> TheFieldCache;
+
 struct CFrame {	/* proc/func call stack frame */
 	Symbol			sp;					/* symbol table entry */
 	int				retPC;				/* where to resume after return */
@@ -404,6 +430,9 @@ private:
 public:
 	ScriptType event2script(LEvent ev);
 	Symbol getHandler(const Common::String &name);
+	const HandlerCacheEntry &lookupHandler(const Common::String &name, bool allowRetVal);
+	static void invalidateHandlerCache();
+	const inst *getCallSite() const;
 
 	void processEvents(Common::Queue<LingoEvent> &queue, bool isInputEvent);
 
@@ -493,6 +522,7 @@ public:
 	void setTheChunk(Datum &chunk, int field, Datum &d);
 	void getObjectProp(Datum &obj, Common::String &propName);
 	void setObjectProp(Datum &obj, Common::String &propName, Datum &d);
+	const TheEntityField *lookupTheField(int entity, const Common::String &propName);
 	Datum getTheDate(int field);
 	Datum getTheTime(int field);
 	Datum getTheDeskTopRectList();
@@ -516,6 +546,8 @@ public:
 
 	TheEntityHash _theEntities;
 	TheEntityFieldHash _theEntityFields;
+	HandlerCache _handlerCache;			// call sites outside of any script context
+	uint32 _handlerCacheGeneration;
 
 	int _objectEntityId;
 
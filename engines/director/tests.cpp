@@ -38,6 +38,7 @@
 #include "director/movie.h"
 #include "director/picture.h"
 #include "director/window.h"
+#include "director/lingo/lingo.h"
 
 #include "image/pict.h"
 
@@ -165,6 +166,140 @@ void Window::testFonts() {
 	delete fontFile;
 }
 
+//////////////////////
+// Ink tests
+//////////////////////
+static bool sameSurface(const Graphics::ManagedSurface &a, const Graphics::ManagedSurface &b) {
+	for (int y = 0; y < a.h; y++) {
+		if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+			return false;
+	}
+	return true;
+}
+
+// Checks that the row blitters give the same result as drawing every pixel
+// with InkPrimitives::drawPoint, for the inks they handle
+void Window::testInkBlitRows() {
+	const InkType inks[] = { kInkTypeCopy, kInkTypeMatte, kInkTypeMask, kInkTypeBlend, kInkTypeBackgndTrans };
+	const int alphas[] = { 0, 100 };
+	// Sprite positions on the 40x30 surface, the last ones are clipped at its edges
+	const Common::Point positions[] = { Common::Point(4, 5), Common::Point(-5, -3), Common::Point(30, 22), Common::Point(-2, 20) };
+
+	const uint32 colors[] = {
+		_wm->_colorWhite, _wm->_colorBlack,
+		_wm->findBestColor(0xff, 0x00, 0x00), _wm->findBestColor(0x00, 0x80, 0xff), _wm->findBestColor(0x40, 0xc0, 0x40)
+	};
+	const uint32 backColor = colors[0];
+	const uint32 foreColor = colors[1];
+
+	Graphics::ManagedSurface sprite, background, rows, pixels;
+	Graphics::Surface mask;
+
+	sprite.create(16, 12, _wm->_pixelformat);
+	mask.create(16, 12, Graphics::PixelFormat::createFormatCLUT8());
+	for (int y = 0; y < sprite.h; y++) {
+		for (int x = 0; x < sprite.w; x++) {
+			sprite.setPixel(x, y, colors[(x + 2 * y) % ARRAYSIZE(colors)]);
+			mask.setPixel(x, y, ((x ^ y) & 1) ? 0xff : 0);
+		}
+	}
+
+	background.create(40, 30, _wm->_pixelformat);
+	for (int y = 0; y < background.h; y++) {
+		for (int x = 0; x < background.w; x++)
+			background.setPixel(x, y, colors[(3 * x + y) % ARRAYSIZE(colors)]);
+	}
+
+	int cases = 0, failures = 0;
+
+	for (uint pos = 0; pos < ARRAYSIZE(positions); pos++) {
+		Common::Rect srcRect(positions[pos].x, positions[pos].y, positions[pos].x + sprite.w, positions[pos].y + sprite.h);
+		Common::Rect destRect = srcRect.findIntersectingRect(background.getBounds());
+
+		for (uint i = 0; i < ARRAYSIZE(inks); i++) {
+			for (uint a = 0; a < ARRAYSIZE(alphas); a++) {
+				for (int m = 0; m < 2; m++) {
+					const Graphics::Surface *msk = m ? &mask : nullptr;
+
+					DirectorPlotData pd(_vm, kBitmapSprite, inks[i], alphas[a], backColor, foreColor);
+					pd.srf = &sprite;
+					pd.destRect = destRect;
+
+					rows.copyFrom(background);
+					pd.dst = &rows;
+					cases++;
+					if (!pd.inkBlitSurfaceRows(srcRect, msk)) {
+						warning("testInkBlitRows(): ink %d, alpha %d, mask %d at %d,%d was not drawn by rows",
+								inks[i], alphas[a], m, srcRect.left, srcRect.top);
+						failures++;
+						continue;
+					}
+
+					pixels.copyFrom(background);
+					pd.dst = &pixels;
+					pd.inkBlitSurfacePixels(srcRect, msk);
+
+					if (!sameSurface(rows, pixels)) {
+						warning("testInkBlitRows(): ink %d, alpha %d, mask %d at %d,%d differs from drawPoint",
+								inks[i], alphas[a], m, srcRect.left, srcRect.top);
+						failures++;
+					}
+				}
+			}
+		}
+	}
+
+	// A sprite reaching past its surface is left to the per-pixel path
+	DirectorPlotData pd(_vm, kBitmapSprite, kInkTypeCopy, 0, backColor, foreColor);
+	Common::Rect srcRect(2, 2, 2 + sprite.w + 4, 2 + sprite.h);
+	pd.srf = &sprite;
+	pd.dst = &rows;
+	pd.destRect = srcRect;
+	cases++;
+	if (pd.inkBlitSurfaceRows(srcRect, nullptr)) {
+		warning("testInkBlitRows(): sprite past its surface was drawn by rows");
+		failures++;
+	}
+
+	debug("testInkBlitRows(): %d cases, %d failed", cases, failures);
+
+	sprite.free();
+	mask.free();
+	background.free();
+	rows.free();
+	pixels.free();
+}
+
+//////////////////////
+// Lingo tests
+//////////////////////
+// Calls a handler from the same call site before and after it gets
+// patched, to make sure the call site cache looks it up again
+void Window::testHandlerCache() {
+	const uint16 targetId = 1000, callerId = 1001;
+	LingoArchive *archive = _currentMovie->getMainLingoArch();
+
+	archive->addCode(Common::U32String("on cacheTarget\n  return 1\nend\n"), kMovieScript, targetId);
+	archive->addCode(Common::U32String("global gCacheResult\ndo \"put 1 into x\"\nset gCacheResult = cacheTarget()\n"), kTestScript, callerId);
+
+	g_lingo->executeScript(kTestScript, CastMemberID(callerId, DEFAULT_CAST_LIB));
+	int before = g_lingo->_globalvars.getValOrDefault("gCacheResult").asInt();
+
+	archive->patchCode(Common::U32String("on cacheTarget\n  return 2\nend\n"), kMovieScript, targetId);
+
+	g_lingo->executeScript(kTestScript, CastMemberID(callerId, DEFAULT_CAST_LIB));
+	int after = g_lingo->_globalvars.getValOrDefault("gCacheResult").asInt();
+
+	if (before != 1 || after != 2)
+		warning("testHandlerCache(): got %d and %d, expected 1 and 2", before, after);
+	else
+		debug("testHandlerCache(): redefined handler was looked up again");
+
+	archive->removeCode(kTestScript, callerId);
+	archive->removeCode(kMovieScript, targetId);
+	g_lingo->_globalvars.erase("gCacheResult");
+}
+
 //////////////////////
 // Movie iteration
 //////////////////////
@@ -339,6 +474,9 @@ void Window::runTests() {
 		testFonts();
 	}
 
+	testInkBlitRows();
+	testHandlerCache();
+
 	g_lingo->runTests();
 }
 
@@ -178,6 +178,8 @@ public:
 	Common::HashMap<Common::String, Movie *> *scanMovies(const Common::Path &folder);
 	void testFontScaling();
 	void testFonts();
+	void testInkBlitRows();
+	void testHandlerCache();
 	void enqueueAllMovies();
 	MovieReference getNextMovieFromQueue();
 	void runTests();
@@ -31,6 +31,7 @@
 #include "common/translation.h"
 
 #include "engines/dialogs.h"
+#include "engines/savemetaindex.h"
 
 #include "graphics/scaler.h"
 #include "graphics/managed_surface.h"
@@ -409,6 +410,12 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		}
 	}
 
+	// Forget deleted saves, and store what was read from new ones. The
+	// entries are loaded again on the next query, so don't keep the
+	// thumbnails around.
+	SaveMetaIndex::instance().prune(target ? target : getName(), filenames);
+	SaveMetaIndex::instance().release();
+
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
 	return saveList;
@@ -462,6 +469,10 @@ GUI::OptionsContainerWidget *MetaEngine::buildEngineOptionsWidget(GUI::GuiObject
 	return new GUI::ExtraGuiOptionsWidget(boss, name, target, engineOptions);
 }
 
+void MetaEngine::invalidateSaveMetaInfos(const Common::String &filename) {
+	SaveMetaIndex::instance().invalidate(filename);
+}
+
 bool MetaEngine::removeSaveState(const char *target, int slot) const {
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return false;
@@ -473,19 +484,66 @@ SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot)
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateDescriptor();
 
-	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(
-		getSavegameFile(slot, target)));
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	const Common::String filename = getSavegameFile(slot, target);
+	const Common::String indexTarget = target ? target : getName();
+
+	// Use the save index if the save did not change since it was recorded
+	int64 size = 0, mtime = 0;
+	const bool hasStat = saveFileMan->getSavefileStat(filename, size, mtime);
+	if (hasStat) {
+		const SaveMetaIndex::Entry *entry = SaveMetaIndex::instance().find(indexTarget, filename, size, mtime);
+		if (entry) {
+			if (!entry->valid)
+				return SaveStateDescriptor();
+
+			ExtendedSavegameHeader header;
+			header.date = entry->date;
+			header.time = entry->time;
+			header.playtime = entry->playtime;
+			header.description = entry->description;
+
+			SaveStateDescriptor desc(this, slot, Common::U32String());
+			parseSavegameHeader(&header, &desc);
+			desc.setThumbnail(entry->thumbnail);
+			desc.setAutosave(entry->isAutosave);
+			return desc;
+		}
+	}
+
+	Common::ScopedPtr<Common::InSaveFile> f(saveFileMan->openForLoading(filename));
 
 	if (f) {
 		ExtendedSavegameHeader header;
+		SaveMetaIndex::Entry entry;
+		entry.size = size;
+		entry.mtime = mtime;
+
 		if (!readSavegameHeader(f.get(), &header, false)) {
+			if (hasStat)
+				SaveMetaIndex::instance().set(indexTarget, filename, entry);
 			return SaveStateDescriptor();
 		}
 
+		Common::SharedPtr<Graphics::Surface> thumbnail;
+		if (header.thumbnail)
+			thumbnail = Common::SharedPtr<Graphics::Surface>(header.thumbnail, Graphics::SurfaceDeleter());
+
+		if (hasStat) {
+			entry.valid = true;
+			entry.date = header.date;
+			entry.time = header.time;
+			entry.playtime = header.playtime;
+			entry.description = header.description;
+			entry.isAutosave = header.isAutosave;
+			entry.thumbnail = thumbnail;
+			SaveMetaIndex::instance().set(indexTarget, filename, entry);
+		}
+
 		// Create the return descriptor
 		SaveStateDescriptor desc(this, slot, Common::U32String());
 		parseSavegameHeader(&header, &desc);
-		desc.setThumbnail(header.thumbnail);
+		desc.setThumbnail(thumbnail);
 		desc.setAutosave(header.isAutosave);
 		return desc;
 	}
@@ -592,6 +592,13 @@ public:
 	 * Read the extended savegame header from the given savegame file.
 	 */
 	WARN_UNUSED_RESULT static bool readSavegameHeader(Common::InSaveFile *in, ExtendedSavegameHeader *header, bool skipThumbnail = true);
+
+	/**
+	 * Forget the metadata recorded for a save file by querySaveMetaInfos().
+	 *
+	 * Savefile managers call this when a save file is written or removed.
+	 */
+	static void invalidateSaveMetaInfos(const Common::String &filename);
 };
 
 /**
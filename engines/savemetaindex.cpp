@@ -0,0 +1,223 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "engines/savemetaindex.h"
+
+#include "common/config-manager.h"
+#include "common/fs.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+#include "graphics/surface.h"
+#include "graphics/thumbnail.h"
+
+namespace Common {
+DECLARE_SINGLETON(SaveMetaIndex);
+}
+
+enum {
+	kSaveMetaIndexVersion = 2
+};
+
+Common::Path SaveMetaIndex::getDirectory() const {
+	if (!_directory.empty())
+		return _directory;
+
+	Common::Path configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+
+	return configFile.getParent().appendComponent("saveindex");
+}
+
+Common::Path SaveMetaIndex::getFilename() const {
+	return getDirectory().appendComponent(_target + ".saveindex");
+}
+
+void SaveMetaIndex::select(const Common::String &target) {
+	if (_target == target)
+		return;
+
+	flush();
+
+	_entries.clear();
+	_target = target;
+	load();
+}
+
+void SaveMetaIndex::load() {
+	Common::FSNode node(getFilename());
+	Common::ScopedPtr<Common::SeekableReadStream> in(node.createReadStream());
+	if (!in)
+		return;
+
+	const Common::String name = node.getPath().toString(Common::Path::kNativeSeparator);
+
+	if (in->readUint32BE() != MKTAG('S', 'V', 'M', 'I') || in->readUint32LE() != kSaveMetaIndexVersion)
+		return;
+
+	uint32 count = in->readUint32LE();
+
+	for (uint32 i = 0; i < count; i++) {
+		uint32 filenameLen = in->readUint32LE();
+		Common::String filename = in->readString(0, filenameLen);
+
+		Entry entry;
+		entry.size = in->readSint64LE();
+		entry.mtime = in->readSint64LE();
+		entry.valid = in->readByte() != 0;
+
+		if (entry.valid) {
+			entry.date = in->readUint32LE();
+			entry.time = in->readUint16LE();
+			entry.playtime = in->readUint32LE();
+			uint32 descriptionLen = in->readUint32LE();
+			entry.description = in->readString(0, descriptionLen);
+			entry.isAutosave = in->readByte() != 0;
+
+			if (in->readByte()) {
+				Graphics::Surface *thumbnail = nullptr;
+				if (!Graphics::loadThumbnail(*in, thumbnail)) {
+					warning("Corrupt save index '%s', discarding it", name.c_str());
+					_entries.clear();
+					return;
+				}
+				entry.thumbnail = Common::SharedPtr<Graphics::Surface>(thumbnail, Graphics::SurfaceDeleter());
+			}
+		}
+
+		if (in->err() || in->eos()) {
+			warning("Truncated save index '%s', discarding it", name.c_str());
+			_entries.clear();
+			return;
+		}
+
+		if (_changed.contains(filename)) {
+			_dirty = true;
+			continue;
+		}
+
+		_entries.setVal(filename, entry);
+	}
+}
+
+void SaveMetaIndex::flush() {
+	if (!_dirty)
+		return;
+
+	_dirty = false;
+
+	Common::FSNode directory(getDirectory());
+	if (!directory.exists() && !directory.createDirectory()) {
+		warning("Unable to create save index directory '%s'", directory.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	Common::FSNode node(getFilename());
+	const Common::String name = node.getPath().toString(Common::Path::kNativeSeparator);
+
+	Common::ScopedPtr<Common::SeekableWriteStream> out(node.createWriteStream());
+	if (!out) {
+		warning("Unable to write save index '%s'", name.c_str());
+		return;
+	}
+
+	out->writeUint32BE(MKTAG('S', 'V', 'M', 'I'));
+	out->writeUint32LE(kSaveMetaIndexVersion);
+	out->writeUint32LE(_entries.size());
+
+	for (const auto &it : _entries) {
+		const Entry &entry = it._value;
+
+		out->writeUint32LE(it._key.size());
+		out->writeString(it._key);
+
+		out->writeSint64LE(entry.size);
+		out->writeSint64LE(entry.mtime);
+		out->writeByte(entry.valid);
+
+		if (entry.valid) {
+			out->writeUint32LE(entry.date);
+			out->writeUint16LE(entry.time);
+			out->writeUint32LE(entry.playtime);
+			out->writeUint32LE(entry.description.size());
+			out->writeString(entry.description);
+			out->writeByte(entry.isAutosave);
+			out->writeByte(entry.thumbnail ? 1 : 0);
+			if (entry.thumbnail)
+				Graphics::saveThumbnail(*out, *entry.thumbnail);
+		}
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("Unable to write save index '%s'", name.c_str());
+}
+
+void SaveMetaIndex::release() {
+	flush();
+
+	_entries.clear();
+	_target.clear();
+}
+
+const SaveMetaIndex::Entry *SaveMetaIndex::find(const Common::String &target, const Common::String &filename, int64 size, int64 mtime) {
+	select(target);
+
+	EntryMap::const_iterator it = _entries.find(filename);
+	if (it == _entries.end() || it->_value.size != size || it->_value.mtime != mtime)
+		return nullptr;
+
+	return &it->_value;
+}
+
+void SaveMetaIndex::set(const Common::String &target, const Common::String &filename, const Entry &entry) {
+	select(target);
+
+	_entries.setVal(filename, entry);
+	_changed.erase(filename);
+	_dirty = true;
+}
+
+void SaveMetaIndex::invalidate(const Common::String &filename) {
+	_changed[filename] = true;
+
+	EntryMap::iterator it = _entries.find(filename);
+	if (it != _entries.end()) {
+		_entries.erase(it);
+		_dirty = true;
+	}
+}
+
+void SaveMetaIndex::prune(const Common::String &target, const Common::StringArray &filenames) {
+	select(target);
+
+	FilenameMap present;
+	for (const auto &filename : filenames)
+		present[filename] = true;
+
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (!present.contains(it->_key)) {
+			_entries.erase(it);
+			_dirty = true;
+		}
+	}
+}
@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ENGINES_SAVEMETAINDEX_H
+#define ENGINES_SAVEMETAINDEX_H
+
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/path.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "common/str-array.h"
+
+namespace Graphics {
+struct Surface;
+}
+
+/**
+ * Metadata of the extended saves of one target, used by the default
+ * MetaEngine::querySaveMetaInfos(). Listing the saves then only needs to read
+ * the index instead of opening and decompressing every save.
+ *
+ * The index is kept next to the configuration file rather than in the save
+ * directory, so it is neither listed nor synced like a save.
+ *
+ * Entries are only used while the size and modification time of their save
+ * file are unchanged, so saves changed outside of ScummVM are read again.
+ * Saves written or removed through the savefile manager are invalidated
+ * directly, since the modification time may only have a one second
+ * resolution.
+ */
+class SaveMetaIndex : public Common::Singleton<SaveMetaIndex> {
+public:
+	struct Entry {
+		int64 size;
+		int64 mtime;
+		bool valid;                  // False if the save has no valid extended header
+		uint32 date;
+		uint16 time;
+		uint32 playtime;
+		Common::String description;
+		bool isAutosave;
+		Common::SharedPtr<Graphics::Surface> thumbnail;
+
+		Entry() {
+			size = 0;
+			mtime = 0;
+			valid = false;
+			date = 0;
+			time = 0;
+			playtime = 0;
+			isAutosave = false;
+		}
+	};
+
+	/** Use the "saveindex" directory next to the configuration file. */
+	SaveMetaIndex() : _dirty(false) {}
+
+	/** Keep the index files in the given directory. */
+	explicit SaveMetaIndex(const Common::Path &directory) : _directory(directory), _dirty(false) {}
+
+	/** Look up the entry of a save file, if it is still up to date. */
+	const Entry *find(const Common::String &target, const Common::String &filename, int64 size, int64 mtime);
+
+	/** Record the metadata of a save file. */
+	void set(const Common::String &target, const Common::String &filename, const Entry &entry);
+
+	/** Forget the save files not in the given list. */
+	void prune(const Common::String &target, const Common::StringArray &filenames);
+
+	/** Forget a save file that was written or removed. */
+	void invalidate(const Common::String &filename);
+
+	/** Write the index of the current target if it changed. */
+	void flush();
+
+	/** Write the index if it changed, and free its entries. */
+	void release();
+
+private:
+	typedef Common::HashMap<Common::String, Entry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> EntryMap;
+	typedef Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FilenameMap;
+
+	void select(const Common::String &target);
+	void load();
+
+	Common::Path getDirectory() const;
+	Common::Path getFilename() const;
+
+	Common::Path _directory;
+	Common::String _target;
+	EntryMap _entries;
+	FilenameMap _changed;        // Save files written or removed since they were recorded
+	bool _dirty;
+};
+
+#endif
@@ -91,6 +91,7 @@ struct DebugState {
 extern int g_debug_sleeptime_factor;
 extern int g_debug_simulated_key;
 extern bool g_debug_track_mouse_clicks;
+extern bool g_debug_vm_instruction_cache;
 
 } // End of namespace Sci
 
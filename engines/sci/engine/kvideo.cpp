@@ -49,6 +49,9 @@
 namespace Sci {
 
 void playVideo(Video::VideoDecoder &videoDecoder) {
+	// Decode a few frames ahead while waiting, so that a slow frame does not
+	// stall playback
+	videoDecoder.setDecodeAhead(4);
 	videoDecoder.start();
 
 	Common::SpanOwner<SciSpan<byte> > scaleBuffer;
@@ -109,7 +112,7 @@ void playVideo(Video::VideoDecoder &videoDecoder) {
 		if (g_sci->getEngineState()->_delayedRestoreGameId != -1)
 			skipVideo = true;
 
-		g_system->delayMillis(10);
+		videoDecoder.delayMillis(10);
 	}
 }
 reg_t kShowMovie(EngineState *s, int argc, reg_t *argv) {
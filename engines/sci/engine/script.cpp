@@ -70,6 +70,9 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_markedAsDeleted = false;
 	_objects.clear();
 
+	_instructionIndex.clear();
+	_instructions.clear();
+
 	_offsetLookupArray.clear();
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
@@ -947,6 +950,28 @@ SciSpan<const byte> Script::findBlockSCI0(ScriptObjectTypes type, bool findLastB
 	return foundBlock;
 }
 
+const PMachineInstruction &Script::getInstruction(uint32 offset) {
+	if (_instructionIndex.empty())
+		_instructionIndex.resize(_buf->size());
+
+	const uint16 index = _instructionIndex[offset];
+	if (index)
+		return _instructions[index - 1];
+
+	PMachineInstruction instruction;
+	instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, instruction.opparams);
+
+	// The index can't address any more instructions, so just hand out this one
+	if (_instructions.size() >= 0xFFFF) {
+		_uncachedInstruction = instruction;
+		return _uncachedInstruction;
+	}
+
+	_instructions.push_back(instruction);
+	_instructionIndex[offset] = _instructions.size();
+	return _instructions.back();
+}
+
 // memory operations
 
 bool Script::isValidOffset(uint32 offset) const {
@@ -93,6 +93,15 @@ private:
 
 	ObjMap _objects;	/**< Table for objects, contains property variables */
 
+	/**
+	 * Instructions decoded by getInstruction(). For each offset into _buf,
+	 * _instructionIndex holds the position of its instruction in
+	 * _instructions plus one, or 0 if it has not been decoded yet.
+	 */
+	Common::Array<uint16> _instructionIndex;
+	Common::Array<PMachineInstruction> _instructions;
+	PMachineInstruction _uncachedInstruction;
+
 protected:
 	offsetLookupArrayType _offsetLookupArray; // Table of all elements of currently loaded script, that may get pointed to
 
@@ -117,6 +126,12 @@ public:
 	}
 
 	const byte *getBuf(uint offset = 0) const { return _buf->getUnsafeDataAt(offset); }
+
+	/**
+	 * Returns the instruction at the given offset, decoding it on first use.
+	 * The returned reference is only valid until the next call.
+	 */
+	const PMachineInstruction &getInstruction(uint32 offset);
 	SciSpan<const byte> getSpan(uint offset) const { return _buf->subspan(offset); }
 
 	int getScriptNumber() const { return _nr; }
@@ -416,6 +416,15 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
  */
 int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]);
 
+/**
+ * A PMachine instruction as decoded by readPMachineInstruction().
+ */
+struct PMachineInstruction {
+	uint16 size;		/**< length in bytes of the instruction */
+	byte extOpcode;		/**< "extended" opcode of the instruction */
+	int16 opparams[4];	/**< parameters of the instruction */
+};
+
 /**
  * Finds the script-absolute offset of a relative object offset.
  *
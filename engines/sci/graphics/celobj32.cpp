@@ -83,14 +83,21 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 
 #pragma mark -
 #pragma mark CelObj
+
+enum {
+	/**
+	 * The default memory budget of the cel cache, in bytes.
+	 */
+	kCelCacheMaxMemory = 4 * 1024 * 1024
+};
+
 bool CelObj::_drawBlackLines = false;
 
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
-	_nextCacheId = 1;
 	_scaler = new CelScaler();
-	_cache = new CelCache(100);
+	_cache = new CelCache(kCelCacheMaxMemory);
 }
 
 void CelObj::deinit() {
@@ -368,77 +375,102 @@ private:
 	uint32 _dataOffset;
 	uint32 _uncompressedDataOffset;
 	int16 _y;
+	const int16 _sourceWidth;
 	const int16 _sourceHeight;
 	const uint8 _skipColor;
 	const int16 _maxWidth;
+	const byte *_pixels;
+
+	void decompressRow(const int16 y, const int16 width) {
+		// compressed data segment for row
+		const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
+
+		uint32 rowCompressedSize;
+		if (y + 1 < _sourceHeight) {
+			rowCompressedSize = _resource.getUint32SEAt(_controlOffset + (y + 1) * sizeof(uint32)) - rowOffset;
+		} else {
+			rowCompressedSize = _resource.size() - rowOffset - _dataOffset;
+		}
+
+		const byte *row = _resource.getUnsafeDataAt(_dataOffset + rowOffset, rowCompressedSize);
+
+		// uncompressed data segment for row
+		const uint32 literalOffset = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + y * sizeof(uint32));
+
+		uint32 literalRowSize;
+		if (y + 1 < _sourceHeight) {
+			literalRowSize = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + (y + 1) * sizeof(uint32)) - literalOffset;
+		} else {
+			literalRowSize = _resource.size() - literalOffset - _uncompressedDataOffset;
+		}
+
+		const byte *literal = _resource.getUnsafeDataAt(_uncompressedDataOffset + literalOffset, literalRowSize);
+
+		uint8 length;
+		for (int16 i = 0; i < width; i += length) {
+			const byte controlByte = *row++;
+			length = controlByte;
+
+			// Run-length encoded
+			if (controlByte & 0x80) {
+				length &= 0x3F;
+				assert(i + length < (int)sizeof(_buffer));
+
+				// Fill with skip color
+				if (controlByte & 0x40) {
+					memset(_buffer + i, _skipColor, length);
+				// Next value is fill color
+				} else {
+					memset(_buffer + i, *literal, length);
+					++literal;
+				}
+			// Uncompressed
+			} else {
+				assert(i + length < (int)sizeof(_buffer));
+				memcpy(_buffer + i, literal, length);
+				literal += length;
+			}
+		}
+	}
 
 public:
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
 	_resource(celObj.getResPointer()),
 	_y(-1),
+	_sourceWidth(celObj._width),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
-	_maxWidth(maxWidth) {
+	_maxWidth(maxWidth),
+	_pixels(nullptr) {
 		assert(maxWidth <= celObj._width);
 
 		const SciSpan<const byte> celHeader = _resource.subspan(celObj._celHeaderOffset);
 		_dataOffset = celHeader.getUint32SEAt(24);
 		_uncompressedDataOffset = celHeader.getUint32SEAt(28);
 		_controlOffset = celHeader.getUint32SEAt(32);
+
+		if (celObj._pixels) {
+			CelPixels &pixels = *celObj._pixels;
+			if (pixels.data.empty()) {
+				pixels.data.resize(_sourceWidth * _sourceHeight);
+				for (int16 y = 0; y < _sourceHeight; ++y) {
+					decompressRow(y, _sourceWidth);
+					memcpy(pixels.data.begin() + y * _sourceWidth, _buffer, _sourceWidth);
+				}
+				CelObj::getCache().addPixels(pixels);
+			}
+			_pixels = pixels.data.begin();
+		}
 	}
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
-		if (y != _y) {
-			// compressed data segment for row
-			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
-
-			uint32 rowCompressedSize;
-			if (y + 1 < _sourceHeight) {
-				rowCompressedSize = _resource.getUint32SEAt(_controlOffset + (y + 1) * sizeof(uint32)) - rowOffset;
-			} else {
-				rowCompressedSize = _resource.size() - rowOffset - _dataOffset;
-			}
-
-			const byte *row = _resource.getUnsafeDataAt(_dataOffset + rowOffset, rowCompressedSize);
-
-			// uncompressed data segment for row
-			const uint32 literalOffset = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + y * sizeof(uint32));
-
-			uint32 literalRowSize;
-			if (y + 1 < _sourceHeight) {
-				literalRowSize = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + (y + 1) * sizeof(uint32)) - literalOffset;
-			} else {
-				literalRowSize = _resource.size() - literalOffset - _uncompressedDataOffset;
-			}
-
-			const byte *literal = _resource.getUnsafeDataAt(_uncompressedDataOffset + literalOffset, literalRowSize);
-
-			uint8 length;
-			for (int16 i = 0; i < _maxWidth; i += length) {
-				const byte controlByte = *row++;
-				length = controlByte;
-
-				// Run-length encoded
-				if (controlByte & 0x80) {
-					length &= 0x3F;
-					assert(i + length < (int)sizeof(_buffer));
+		if (_pixels) {
+			return _pixels + y * _sourceWidth;
+		}
 
-					// Fill with skip color
-					if (controlByte & 0x40) {
-						memset(_buffer + i, _skipColor, length);
-					// Next value is fill color
-					} else {
-						memset(_buffer + i, *literal, length);
-						++literal;
-					}
-				// Uncompressed
-				} else {
-					assert(i + length < (int)sizeof(_buffer));
-					memcpy(_buffer + i, literal, length);
-					literal += length;
-				}
-			}
+		if (y != _y) {
+			decompressRow(y, _maxWidth);
 			_y = y;
 		}
 
@@ -698,45 +730,121 @@ void CelObj::submitPalette() const {
 #pragma mark -
 #pragma mark CelObj - Caching
 
-int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
 
-int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
-	*nextInsertIndex = -1;
-	int oldestId = _nextCacheId + 1;
-	int oldestIndex = 0;
+void CelObj::putCopyInCache() const {
+	_cache->put(duplicate());
+}
 
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+CelCache::CelCache(const uint32 maxMemory) :
+	_memory(0),
+	_maxMemory(maxMemory) {
+	resetStats();
+}
 
-		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
-		} else if (oldestId > entry.id) {
-			oldestId = entry.id;
-			oldestIndex = i;
-		}
+CelCache::~CelCache() {
+	clear();
+}
+
+uint CelCache::CelInfoHash::operator()(const CelInfo32 &celInfo) const {
+	uint hash = celInfo.type;
+	hash = hash * 31 + celInfo.resourceId;
+	hash = hash * 31 + (uint16)celInfo.loopNo;
+	hash = hash * 31 + (uint16)celInfo.celNo;
+	hash = hash * 31 + celInfo.bitmap.getSegment();
+	hash = hash * 31 + celInfo.bitmap.getOffset();
+	return hash;
+}
+
+bool CelCache::CelInfoEqualTo::operator()(const CelInfo32 &a, const CelInfo32 &b) const {
+	return a == b;
+}
+
+const CelObj *CelCache::find(const CelInfo32 &celInfo) {
+	CelMap::iterator it = _cels.find(celInfo);
+	if (it == _cels.end()) {
+		++_stats.misses;
+		return nullptr;
+	}
+
+	++_stats.hits;
+
+	// Move the cel to the front of the LRU list
+	CelObj *const celObj = *it->_value;
+	_lru.erase(it->_value);
+	_lru.push_front(celObj);
+	it->_value = _lru.begin();
+	return celObj;
+}
+
+void CelCache::put(CelObj *celObj) {
+	CelMap::iterator it = _cels.find(celObj->_info);
+	if (it != _cels.end()) {
+		remove(it->_value);
 	}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
+	if (celObj->_pixels) {
+		celObj->_pixels->cached = true;
 	}
 
-	return -1;
+	_lru.push_front(celObj);
+	_cels[celObj->_info] = _lru.begin();
+	_memory += getCelSize(*celObj);
+	evict();
 }
 
-void CelObj::putCopyInCache(const int cacheIndex) const {
-	if (cacheIndex == -1) {
-		error("Invalid cache index");
+void CelCache::addPixels(const CelPixels &pixels) {
+	if (pixels.cached) {
+		_memory += pixels.data.size();
+		evict();
 	}
+}
+
+void CelCache::clear() {
+	while (!_lru.empty()) {
+		remove(_lru.begin());
+	}
+}
+
+void CelCache::setMaxMemory(const uint32 maxMemory) {
+	_maxMemory = maxMemory;
+	evict();
+}
+
+void CelCache::resetStats() {
+	_stats.hits = 0;
+	_stats.misses = 0;
+	_stats.evictions = 0;
+}
+
+uint32 CelCache::getCelSize(const CelObj &celObj) const {
+	uint32 size = sizeof(CelObjPic);
+	if (celObj._pixels && celObj._pixels->cached) {
+		size += celObj._pixels->data.size();
+	}
+	return size;
+}
+
+void CelCache::remove(CelList::iterator it) {
+	CelObj *const celObj = *it;
+	_memory -= getCelSize(*celObj);
+	if (celObj->_pixels) {
+		celObj->_pixels->cached = false;
+	}
+
+	_cels.erase(celObj->_info);
+	_lru.erase(it);
+	delete celObj;
+}
 
-	CelCacheEntry &entry = (*_cache)[cacheIndex];
-	entry.celObj.reset(duplicate());
-	entry.id = ++_nextCacheId;
+void CelCache::evict() {
+	// The most recently used cel is always kept, even if it alone exceeds the
+	// budget, since it is about to be drawn
+	while (_memory > _maxMemory && _lru.size() > 1) {
+		CelList::iterator it = _lru.end();
+		remove(--it);
+		++_stats.evictions;
+	}
 }
 
 #pragma mark -
@@ -983,16 +1091,13 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 	_compressionType = kCelCompressionInvalid;
 	_transparent = true;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjView *const cachedCelObj = dynamic_cast<CelObjView *>(entry.celObj.get());
+	const CelObj *const cachedEntry = _cache->find(_info);
+	if (cachedEntry) {
+		const CelObjView *const cachedCelObj = dynamic_cast<const CelObjView *>(cachedEntry);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjView in cache slot %d", cacheIndex);
+			error("Expected a CelObjView in the cel cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1080,6 +1185,10 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 		error("Compression type not supported - V: %d  L: %d  C: %d", _info.resourceId, _info.loopNo, _info.celNo);
 	}
 
+	if (_compressionType == kCelCompressionRLE) {
+		_pixels.reset(new CelPixels());
+	}
+
 	const uint16 flags = celHeader.getUint16SEAt(10);
 	if (flags & 0x80) {
 		_transparent = flags & 1 ? true : false;
@@ -1090,7 +1199,7 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 		_remap = analyzeForRemap();
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjView::analyzeUncompressedForRemap() const {
@@ -1191,16 +1300,13 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 	_transparent = true;
 	_remap = false;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjPic *const cachedCelObj = dynamic_cast<CelObjPic *>(entry.celObj.get());
+	const CelObj *const cachedEntry = _cache->find(_info);
+	if (cachedEntry) {
+		const CelObjPic *const cachedCelObj = dynamic_cast<const CelObjPic *>(cachedEntry);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjPic in cache slot %d", cacheIndex);
+			error("Expected a CelObjPic in the cel cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1264,7 +1370,11 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 		}
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	if (_compressionType == kCelCompressionRLE) {
+		_pixels.reset(new CelPixels());
+	}
+
+	putCopyInCache();
 }
 
 bool CelObjPic::analyzeUncompressedForSkip() const {
@@ -22,6 +22,9 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -103,9 +106,9 @@ struct CelInfo32 {
 		bitmap(NULL_REG),
 		color(0) {}
 
-	// This is the equivalence criteria used by CelObj::searchCache in at least
+	// This is the equivalence criteria used by the cel cache, as in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +118,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -136,17 +139,98 @@ struct CelInfo32 {
 };
 
 class CelObj;
-struct CelCacheEntry {
+
+/**
+ * The decompressed pixels of an RLE compressed cel. The pixels are
+ * decompressed the first time the cel is drawn and are shared by all copies of
+ * the CelObj, including the one in the cel cache.
+ */
+struct CelPixels {
+	Common::Array<byte> data;
+
 	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
+	 * Whether or not the pixels are counted against the memory budget of the
+	 * cel cache.
 	 */
-	int id;
-	Common::ScopedPtr<CelObj> celObj;
-	CelCacheEntry() : id(0) {}
+	bool cached;
+
+	CelPixels() : cached(false) {}
 };
 
-typedef Common::Array<CelCacheEntry> CelCache;
+/**
+ * A cache of cel objects used to avoid reinitialisation overhead for cels with
+ * the same CelInfo32. SSCI kept the 100 most recently used cels; since the
+ * cache also holds decompressed pixels here, it is instead limited by the
+ * memory used by its cels, evicting the least recently used ones first.
+ */
+class CelCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+	};
+
+	CelCache(uint32 maxMemory);
+	~CelCache();
+
+	/**
+	 * Returns the cached cel matching the given CelInfo32, or nullptr if there
+	 * is none.
+	 */
+	const CelObj *find(const CelInfo32 &celInfo);
+
+	/**
+	 * Puts the given cel into the cache, replacing any cel with the same
+	 * CelInfo32. The cache takes ownership of the cel.
+	 */
+	void put(CelObj *celObj);
+
+	/**
+	 * Counts the given newly decompressed pixels against the memory budget, if
+	 * they belong to a cached cel.
+	 */
+	void addPixels(const CelPixels &pixels);
+
+	/**
+	 * Removes all cels from the cache.
+	 */
+	void clear();
+
+	uint size() const { return _lru.size(); }
+	uint32 getMemory() const { return _memory; }
+	uint32 getMaxMemory() const { return _maxMemory; }
+	void setMaxMemory(const uint32 maxMemory);
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	struct CelInfoHash {
+		uint operator()(const CelInfo32 &celInfo) const;
+	};
+
+	struct CelInfoEqualTo {
+		bool operator()(const CelInfo32 &a, const CelInfo32 &b) const;
+	};
+
+	/**
+	 * Cached cels, most recently used first.
+	 */
+	typedef Common::List<CelObj *> CelList;
+	typedef Common::HashMap<CelInfo32, CelList::iterator, CelInfoHash, CelInfoEqualTo> CelMap;
+
+	CelList _lru;
+	CelMap _cels;
+
+	uint32 _memory;
+	uint32 _maxMemory;
+	Stats _stats;
+
+	uint32 getCelSize(const CelObj &celObj) const;
+	void remove(CelList::iterator it);
+	void evict();
+};
 
 #pragma mark -
 #pragma mark CelScaler
@@ -451,29 +535,26 @@ private:
 #pragma mark CelObj - Caching
 protected:
 	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
-	 */
-	static int _nextCacheId;
-
-	/**
-	 * A cache of cel objects used to avoid reinitialisation overhead for cels
-	 * with the same CelInfo32.
+	 * The cel cache, shared by all cels.
 	 */
 	static CelCache *_cache;
 
 	/**
-	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
-	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
-	 * the oldest item in the cache, which can be used to replace the oldest
-	 * item with a newer item.
+	 * The decompressed pixels of this cel, or nullptr if the cel is not
+	 * compressed or should not keep its pixels.
 	 */
-	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
+	Common::SharedPtr<CelPixels> _pixels;
 
 	/**
-	 * Puts a copy of this CelObj into the cache at the given cache index.
+	 * Puts a copy of this CelObj into the cache.
 	 */
-	void putCopyInCache(int index) const;
+	void putCopyInCache() const;
+
+	friend class CelCache;
+	friend struct READER_Compressed;
+
+public:
+	static CelCache &getCache() { return *_cache; }
 };
 
 #pragma mark -
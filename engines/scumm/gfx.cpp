@@ -216,6 +216,10 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+
+	_stripCache.smap = nullptr;
+	_stripCache.height = 0;
+	_stripCache.numZBuffer = 0;
 }
 
 Gdi::~Gdi() {
@@ -285,6 +289,14 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	invalidateStripCache();
+}
+
+void Gdi::invalidateStripCache() {
+	_stripCache.smap = nullptr;
+	_stripCache.valid.clear();
+	_stripCache.pixels.clear();
+	_stripCache.masks.clear();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -1178,7 +1190,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbRoomBackground);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -2381,6 +2393,9 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		limit = numstrip;
 	if (limit > _numStrips - sx)
 		limit = _numStrips - sx;
+
+	const bool useStripCache = prepareStripCache(smap_ptr, vs, y, height, numzbuf, flag);
+
 	for (int k = 0; k < limit; ++k, ++stripnr, ++sx, ++x) {
 		if (y < vs->tdirty[sx])
 			vs->tdirty[sx] = y;
@@ -2395,7 +2410,12 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const bool cachedStrip = useStripCache && readCachedStrip(dstPtr, vs->pitch, x, y, stripnr, numzbuf, zplane_list);
+		bool opaqueStrip = false;
+		if (!cachedStrip) {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+			opaqueStrip = !transpStrip;
+		}
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -2409,7 +2429,13 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (!cachedStrip) {
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+			// Transparent strips depend on what was drawn below them, so they are never cached
+			if (useStripCache && opaqueStrip)
+				writeCachedStrip(dstPtr, vs->pitch, x, y, stripnr, numzbuf, zplane_list);
+		}
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -2445,6 +2471,90 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+/**
+ * Check whether the strips about to be drawn by drawBitmap() can use the room
+ * strip cache, and reset the cache if they do not match what it holds.
+ */
+bool Gdi::prepareStripCache(const byte *smap_ptr, VirtScreen *vs, const int y, const int height, int numzbuf, byte flag) {
+	// Only the full height room background of V5+ games is cached. Older games
+	// and the HE games have their own decoders, masks and palette tricks.
+	if (_vm->_game.version < 5 || _vm->_game.heversion != 0 || flag != dbRoomBackground)
+		return false;
+	if (vs->number != kMainVirtScreen || vs->format.bytesPerPixel != 1 || y != 0 || height != vs->h)
+		return false;
+
+	const int numRoomStrips = _vm->_roomWidth / 8;
+	if (_stripCache.smap != smap_ptr || _stripCache.height != height || _stripCache.numZBuffer != numzbuf ||
+		memcmp(_stripCache.roomPalette, _vm->_roomPalette, sizeof(_stripCache.roomPalette)) != 0 ||
+		_stripCache.valid.size() != (uint)numRoomStrips) {
+		invalidateStripCache();
+		_stripCache.smap = smap_ptr;
+		_stripCache.height = height;
+		_stripCache.numZBuffer = numzbuf;
+		memcpy(_stripCache.roomPalette, _vm->_roomPalette, sizeof(_stripCache.roomPalette));
+		_stripCache.valid.resize(numRoomStrips);
+		for (int i = 0; i < numRoomStrips; i++)
+			_stripCache.valid[i] = false;
+		_stripCache.pixels.resize(numRoomStrips * 8 * height);
+		if (numzbuf > 1)
+			_stripCache.masks.resize(numRoomStrips * (numzbuf - 1) * height);
+	}
+
+	return true;
+}
+
+bool Gdi::readCachedStrip(byte *dstPtr, int dstPitch, int x, const int y, int stripnr, int numzbuf, const byte *zplane_list[9]) {
+	if (stripnr < 0 || stripnr >= (int)_stripCache.valid.size() || !_stripCache.valid[stripnr])
+		return false;
+
+	const int height = _stripCache.height;
+	const byte *src = &_stripCache.pixels[stripnr * 8 * height];
+	for (int h = 0; h < height; h++) {
+		memcpy(dstPtr, src, 8);
+		dstPtr += dstPitch;
+		src += 8;
+	}
+
+	// Z-planes without data for this room are left alone by decodeMask(), so
+	// they are skipped here as well
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		const byte *mask = &_stripCache.masks[(stripnr * (numzbuf - 1) + i - 1) * height];
+		for (int h = 0; h < height; h++)
+			mask_ptr[h * _numStrips] = mask[h];
+	}
+
+	return true;
+}
+
+void Gdi::writeCachedStrip(const byte *srcPtr, int srcPitch, int x, const int y, int stripnr, int numzbuf, const byte *zplane_list[9]) {
+	if (stripnr < 0 || stripnr >= (int)_stripCache.valid.size())
+		return;
+
+	const int height = _stripCache.height;
+	byte *dst = &_stripCache.pixels[stripnr * 8 * height];
+	for (int h = 0; h < height; h++) {
+		memcpy(dst, srcPtr, 8);
+		srcPtr += srcPitch;
+		dst += 8;
+	}
+
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		byte *mask = &_stripCache.masks[(stripnr * (numzbuf - 1) + i - 1) * height];
+		for (int h = 0; h < height; h++)
+			mask[h] = mask_ptr[h * _numStrips];
+	}
+
+	_stripCache.valid[stripnr] = true;
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
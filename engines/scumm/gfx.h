@@ -23,6 +23,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -351,6 +352,25 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
 
+	/**
+	 * Fully decoded room background strips and their z-plane masks. Redrawing
+	 * the background (e.g. when scrolling) copies the strips from here instead
+	 * of decompressing them again. Only opaque strips are kept.
+	 */
+	struct StripCache {
+		const byte *smap;
+		int height;
+		int numZBuffer;
+		byte roomPalette[256];
+		Common::Array<bool> valid;
+		Common::Array<byte> pixels;
+		Common::Array<byte> masks;
+	} _stripCache;
+
+	bool prepareStripCache(const byte *smap_ptr, VirtScreen *vs, const int y, const int height, int numzbuf, byte flag);
+	bool readCachedStrip(byte *dstPtr, int dstPitch, int x, const int y, int stripnr, int numzbuf, const byte *zplane_list[9]);
+	void writeCachedStrip(const byte *srcPtr, int srcPitch, int x, const int y, int stripnr, int numzbuf, const byte *zplane_list[9]);
+
 public:
 	Gdi(ScummEngine *vm);
 	virtual ~Gdi();
@@ -361,6 +381,7 @@ public:
 	virtual void init();
 	virtual void roomChanged(byte *roomptr);
 	virtual void loadTiles(byte *roomptr);
+	void invalidateStripCache();
 	void setTransparentColor(byte transparentColor) { _transparentColor = transparentColor; }
 
 	void drawBitmap(const byte *ptr, VirtScreen *vs, int x, int y, const int width, const int height,
@@ -378,9 +399,10 @@ public:
 	void resetBackground(int top, int bottom, int strip);
 
 	enum DrawBitmapFlags {
-		dbAllowMaskOr   = 1 << 0,
-		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbAllowMaskOr    = 1 << 0,
+		dbDrawMaskOnAll  = 1 << 1,
+		dbObjectMode     = 2 << 2,
+		dbRoomBackground = 1 << 4
 	};
 };
 
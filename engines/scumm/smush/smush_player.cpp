@@ -21,6 +21,7 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/util.h"
 #include "common/rect.h"
@@ -329,6 +330,9 @@ void SmushPlayer::release() {
 	free(_frameBuffer);
 	_frameBuffer = nullptr;
 
+	_frameData.clear();
+	_frameObjectData.clear();
+
 	_IACTstream = nullptr;
 
 	_vm->_smushActive = false;
@@ -809,63 +813,47 @@ void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int t
 	}
 }
 
-void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStream &b) {
+void SmushPlayer::handleZlibFrameObject(const byte *chunk, int32 subSize) {
 	if (_skipNext) {
 		_skipNext = false;
 		return;
 	}
 
-	int32 chunkSize = subSize;
-	byte *chunkBuffer = (byte *)malloc(chunkSize);
-	assert(chunkBuffer);
-	b.read(chunkBuffer, chunkSize);
-
-	unsigned long decompressedSize = READ_BE_UINT32(chunkBuffer);
-	byte *fobjBuffer = (byte *)malloc(decompressedSize);
-	if (!Common::inflateZlib(fobjBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
+	unsigned long decompressedSize = READ_BE_UINT32(chunk);
+	if (_frameObjectData.size() < decompressedSize)
+		_frameObjectData.resize(decompressedSize);
+	if (!Common::inflateZlib(_frameObjectData.data(), &decompressedSize, chunk + 4, subSize - 4))
 		error("SmushPlayer::handleZlibFrameObject() Zlib uncompress error");
-	free(chunkBuffer);
 
-	byte *ptr = fobjBuffer;
+	const byte *ptr = _frameObjectData.data();
 	int codec = READ_LE_UINT16(ptr); ptr += 2;
 	int left = READ_LE_UINT16(ptr); ptr += 2;
 	int top = READ_LE_UINT16(ptr); ptr += 2;
 	int width = READ_LE_UINT16(ptr); ptr += 2;
 	int height = READ_LE_UINT16(ptr); ptr += 2;
 
-	decodeFrameObject(codec, fobjBuffer + 14, left, top, width, height);
-
-	free(fobjBuffer);
+	decodeFrameObject(codec, _frameObjectData.data() + 14, left, top, width, height);
 }
 
-void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b) {
+void SmushPlayer::handleFrameObject(const byte *chunk, int32 subSize) {
 	assert(subSize >= 14);
 	if (_skipNext) {
 		_skipNext = false;
 		return;
 	}
 
-	int codec = b.readUint16LE();
-	int left = b.readUint16LE();
-	int top = b.readUint16LE();
-	int width = b.readUint16LE();
-	int height = b.readUint16LE();
+	int codec = READ_LE_UINT16(chunk);
+	int left = READ_LE_UINT16(chunk + 2);
+	int top = READ_LE_UINT16(chunk + 4);
+	int width = READ_LE_UINT16(chunk + 6);
+	int height = READ_LE_UINT16(chunk + 8);
 
-	b.readUint16LE();
-	b.readUint16LE();
-
-	int32 chunk_size = subSize - 14;
-	byte *chunk_buffer = (byte *)malloc(chunk_size);
-	assert(chunk_buffer);
-	b.read(chunk_buffer, chunk_size);
-
-	decodeFrameObject(codec, chunk_buffer, left, top, width, height);
-
-	free(chunk_buffer);
+	decodeFrameObject(codec, chunk + 14, left, top, width, height);
 }
 
-void SmushPlayer::handleFrame(int32 frameSize, Common::SeekableReadStream &b) {
+void SmushPlayer::handleFrame(const byte *frame, int32 frameSize) {
 	debugC(DEBUG_SMUSH, "SmushPlayer::handleFrame(%d)", _frame);
+	Common::MemoryReadStream b(frame, frameSize);
 	uint8 *audioChunk = nullptr;
 	_skipNext = false;
 
@@ -877,15 +865,18 @@ void SmushPlayer::handleFrame(int32 frameSize, Common::SeekableReadStream &b) {
 		const uint32 subType = b.readUint32BE();
 		const int32 subSize = b.readUint32BE();
 		const int32 subOffset = b.pos();
+		if (subSize < 0 || subOffset + subSize > b.size())
+			error("SmushPlayer::handleFrame() Invalid subChunk %s, %d", tag2str(subType), subSize);
+
 		switch (subType) {
 		case MKTAG('N','P','A','L'):
 			handleNewPalette(subSize, b);
 			break;
 		case MKTAG('F','O','B','J'):
-			handleFrameObject(subSize, b);
+			handleFrameObject(frame + subOffset, subSize);
 			break;
 		case MKTAG('Z','F','O','B'):
-			handleZlibFrameObject(subSize, b);
+			handleZlibFrameObject(frame + subOffset, subSize);
 			break;
 		case MKTAG('P','S','A','D'):
 			if (!_compressedFileMode) {
@@ -1086,7 +1077,11 @@ void SmushPlayer::parseNextFrame() {
 		handleAnimHeader(subSize, *_base);
 		break;
 	case MKTAG('F','R','M','E'):
-		handleFrame(subSize, *_base);
+		if (subSize < 0)
+			error("SmushPlayer::parseNextFrame() Invalid frame at %x, %d", subOffset, subSize);
+		if (_frameData.size() < (uint)subSize)
+			_frameData.resize(subSize);
+		handleFrame(_frameData.data(), _base->read(_frameData.data(), subSize));
 		break;
 	default:
 		error("Unknown Chunk found at %x: %s, %d", subOffset, tag2str(subType), subSize);
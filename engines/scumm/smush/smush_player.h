@@ -22,6 +22,7 @@
 #if !defined(SCUMM_SMUSH_PLAYER_H) && defined(ENABLE_SCUMM_7_8)
 #define SCUMM_SMUSH_PLAYER_H
 
+#include "common/array.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -141,6 +142,11 @@ private:
 	byte *_frameBuffer;
 	byte *_specialBuffer;
 
+	// Reused between frames, so that each frame is read with a single call
+	// and its frame objects are decoded straight from memory
+	Common::Array<byte> _frameData;
+	Common::Array<byte> _frameObjectData;
+
 	Common::String _seekFile;
 	uint32 _startFrame;
 	uint32 _startTime;
@@ -237,10 +243,10 @@ private:
 	bool readString(const char *file);
 	void decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height);
 	void handleAnimHeader(int32 subSize, Common::SeekableReadStream &);
-	void handleFrame(int32 frameSize, Common::SeekableReadStream &);
+	void handleFrame(const byte *frame, int32 frameSize);
 	void handleNewPalette(int32 subSize, Common::SeekableReadStream &);
-	void handleZlibFrameObject(int32 subSize, Common::SeekableReadStream &b);
-	void handleFrameObject(int32 subSize, Common::SeekableReadStream &);
+	void handleZlibFrameObject(const byte *chunk, int32 subSize);
+	void handleFrameObject(const byte *chunk, int32 subSize);
 	void handleSAUDChunk(uint8 *srcBuf, uint32 size, int groupId, int vol, int pan, int16 flags, int trkId, int index, int maxFrames);
 	void handleStore(int32 subSize, Common::SeekableReadStream &);
 	void handleFetch(int32 subSize, Common::SeekableReadStream &);
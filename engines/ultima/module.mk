@@ -551,6 +551,7 @@ MODULE_OBJS += \
 	ultima8/world/monster_egg.o \
 	ultima8/world/snap_process.o \
 	ultima8/world/sort_item.o \
+	ultima8/world/sort_item_list.o \
 	ultima8/world/split_item_process.o \
 	ultima8/world/sprite_process.o \
 	ultima8/world/super_sprite_process.o \
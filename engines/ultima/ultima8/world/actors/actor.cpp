@@ -455,6 +455,7 @@ void Actor::teleport(int newmap, int32 newx, int32 newy, int32 newz) {
 		_x = newx;
 		_y = newy;
 		_z = newz;
+		updateMapBox();
 	}
 }
 
@@ -137,13 +137,18 @@ public:
 	}
 	void setActorFlag(uint32 mask) {
 		_actorFlags |= mask;
-		if (mask & ACT_KNEELING)
+		if (mask & ACT_KNEELING) {
+			// Kneeling changes the height of the main actor in Crusader
 			_cachedShapeInfo = nullptr;
+			updateMapBox();
+		}
 	}
 	void clearActorFlag(uint32 mask) {
 		_actorFlags &= ~mask;
-		if (mask & ACT_KNEELING)
+		if (mask & ACT_KNEELING) {
 			_cachedShapeInfo = nullptr;
+			updateMapBox();
+		}
 	}
 
 	void setCombatTactic(int no) {
@@ -68,11 +68,18 @@ CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
 	for (unsigned int i = 0; i < MAP_NUM_TARGET_ITEMS; i++) {
 		_targets[i] = 0;
 	}
+
+	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
+		for (unsigned int j = 0; j < MAP_NUM_CHUNKS; j++) {
+			_boxes[i][j] = nullptr;
+		}
+	}
 }
 
 
 CurrentMap::~CurrentMap() {
 //	clear();
+	clearItemBoxes();
 }
 
 void CurrentMap::clear() {
@@ -84,6 +91,7 @@ void CurrentMap::clear() {
 		}
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
+	clearItemBoxes();
 
 	_fastXMin =  _fastYMin = _fastXMax = _fastYMax = -1;
 	_currentMap = nullptr;
@@ -120,6 +128,7 @@ void CurrentMap::writeback() {
 			for (auto *item : _items[i][j]) {
 				// item is being removed from the CurrentMap item lists
 				item->clearExtFlag(Item::EXT_INCURMAP);
+				item->_mapBoxIndex = -1;
 
 				// delete all fast only and disposable _items
 				if (item->hasFlags(Item::FLG_FAST_ONLY | Item::FLG_DISPOSABLE)) {
@@ -148,6 +157,7 @@ void CurrentMap::writeback() {
 			_items[i][j].clear();
 		}
 	}
+	clearItemBoxes();
 
 	// delete _eggHatcher
 	Process *ehp = Kernel::get_instance()->getProcess(_eggHatcher);
@@ -248,6 +258,7 @@ void CurrentMap::addItem(Item *item) {
 #endif
 
 	_items[cx][cy].push_front(item);
+	addItemBox(item, cx, cy);
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -283,6 +294,7 @@ void CurrentMap::addItemToEnd(Item *item) {
 #endif
 
 	_items[cx][cy].push_back(item);
+	addItemBox(item, cx, cy);
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -395,6 +407,120 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 
 	_items[cx][cy].remove(item);
 	item->clearExtFlag(Item::EXT_INCURMAP);
+
+	removeItemBox(item);
+}
+
+void CurrentMap::updateItemBox(const Item *item) {
+	// Sprites never collide, so they have no box
+	if (item->_mapBoxIndex < 0)
+		return;
+
+	ChunkBoxes *boxes = _boxes[item->_mapBoxChunk / MAP_NUM_CHUNKS][item->_mapBoxChunk % MAP_NUM_CHUNKS];
+	assert(boxes && boxes->_item[item->_mapBoxIndex] == item);
+	boxes->update(item->_mapBoxIndex, item);
+}
+
+void CurrentMap::addItemBox(Item *item, int32 cx, int32 cy) {
+	if (item->hasExtFlags(Item::EXT_SPRITE))
+		return;
+
+	ChunkBoxes *&boxes = _boxes[cx][cy];
+	if (!boxes)
+		boxes = new ChunkBoxes();
+
+	item->_mapBoxChunk = cx * MAP_NUM_CHUNKS + cy;
+	item->_mapBoxIndex = boxes->add(item);
+}
+
+void CurrentMap::removeItemBox(Item *item) {
+	if (item->_mapBoxIndex < 0)
+		return;
+
+	ChunkBoxes *boxes = _boxes[item->_mapBoxChunk / MAP_NUM_CHUNKS][item->_mapBoxChunk % MAP_NUM_CHUNKS];
+	assert(boxes && boxes->_item[item->_mapBoxIndex] == item);
+
+	// The last box takes the freed slot
+	Item *moved = boxes->remove(item->_mapBoxIndex);
+	if (moved)
+		moved->_mapBoxIndex = item->_mapBoxIndex;
+	item->_mapBoxIndex = -1;
+}
+
+void CurrentMap::clearItemBoxes() {
+	// The items are deleted or written back by now, and get a new slot
+	// when added again
+	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
+		for (unsigned int j = 0; j < MAP_NUM_CHUNKS; j++) {
+			delete _boxes[i][j];
+			_boxes[i][j] = nullptr;
+		}
+	}
+}
+
+Box CurrentMap::ChunkBoxes::getBox(uint index) const {
+	return Box(_x[index], _y[index], _z[index], _xd[index], _yd[index], _zd[index]);
+}
+
+uint CurrentMap::ChunkBoxes::add(Item *item) {
+	_item.push_back(item);
+	_objId.push_back(0);
+	_shapeFlags.push_back(0);
+	_x.push_back(0);
+	_y.push_back(0);
+	_z.push_back(0);
+	_xd.push_back(0);
+	_yd.push_back(0);
+	_zd.push_back(0);
+
+	uint index = _item.size() - 1;
+	update(index, item);
+	return index;
+}
+
+void CurrentMap::ChunkBoxes::update(uint index, const Item *item) {
+	const ShapeInfo *si = item->getShapeInfo();
+	Point3 pt = item->getLocation();
+	int32 xd = 0, yd = 0, zd = 0;
+	if (si)
+		item->getFootpadWorld(xd, yd, zd);
+
+	_objId[index] = item->getObjId();
+	_shapeFlags[index] = si ? si->_flags : 0;
+	_x[index] = pt.x;
+	_y[index] = pt.y;
+	_z[index] = pt.z;
+	_xd[index] = xd;
+	_yd[index] = yd;
+	_zd[index] = zd;
+}
+
+Item *CurrentMap::ChunkBoxes::remove(uint index) {
+	const uint last = _item.size() - 1;
+	Item *moved = nullptr;
+	if (index != last) {
+		moved = _item[last];
+		_item[index] = moved;
+		_objId[index] = _objId[last];
+		_shapeFlags[index] = _shapeFlags[last];
+		_x[index] = _x[last];
+		_y[index] = _y[last];
+		_z[index] = _z[last];
+		_xd[index] = _xd[last];
+		_yd[index] = _yd[last];
+		_zd[index] = _zd[last];
+	}
+
+	_item.pop_back();
+	_objId.pop_back();
+	_shapeFlags.pop_back();
+	_x.pop_back();
+	_y.pop_back();
+	_z.pop_back();
+	_xd.pop_back();
+	_yd.pop_back();
+	_zd.pop_back();
+	return moved;
 }
 
 // Check to see if the chunk is on the screen
@@ -621,14 +747,17 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
+			// Walk the item list, as usecode depends on the order of the
+			// results, but take the boxes from the packed arrays
+			const ChunkBoxes *boxes = _boxes[cx][cy];
 			for (const auto *item : _items[cx][cy]) {
 				if (item->getObjId() == check->getObjId())
 					continue;
-				if (item->hasExtFlags(Item::EXT_SPRITE))
-					continue;
+				if (item->_mapBoxIndex < 0)
+					continue; // sprite
 
 				// check if item is in range?
-				const Box ib = item->getWorldBox();
+				const Box ib = boxes->getBox(item->_mapBoxIndex);
 				if (searchrange.overlapsXY(ib)) {
 					bool ok = false;
 
@@ -713,20 +842,22 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			for (const auto *item : _items[cx][cy]) {
-				if (item->getObjId() == id)
-					continue;
-				if (item->hasExtFlags(Item::EXT_SPRITE))
-					continue;
+			const ChunkBoxes *boxes = _boxes[cx][cy];
+			if (!boxes)
+				continue;
 
-				const ShapeInfo *si = item->getShapeInfo();
-				if (!(si->_flags & flagmask))
+			for (uint i = 0; i < boxes->size(); i++) {
+				const uint32 flags = boxes->_shapeFlags[i];
+				if (!(flags & flagmask))
 					continue; // not an interesting item
+				if (boxes->_objId[i] == id)
+					continue;
 
-				Box ib = item->getWorldBox();
+				const Item *item = boxes->_item[i];
+				const Box ib = boxes->getBox(i);
 
 				// check overlap
-				if ((si->_flags & shapeflags & blockmask) &&
+				if ((flags & shapeflags & blockmask) &&
 					target.overlaps(ib) && !start.overlaps(ib)) {
 					// overlapping an item. Invalid position
 #if 0
@@ -739,12 +870,12 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 
 				if (target.overlapsXY(ib)) {
 					// check support
-					if (si->_flags & supportmask && ib._z + ib._zd > supportz && ib._z + ib._zd <= target._z) {
+					if (flags & supportmask && ib._z + ib._zd > supportz && ib._z + ib._zd <= target._z) {
 						supportz = ib._z + ib._zd;
 					}
 
 					// check roof
-					if (si->is_roof() && ib._z < roofz && ib._z >= target._z + target._zd) {
+					if ((flags & ShapeInfo::SI_ROOF) && ib._z < roofz && ib._z >= target._z + target._zd) {
 						info.roof = item;
 						roofz = ib._z;
 					}
@@ -753,7 +884,7 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 				// check bottom center
 				if (ib.isBelow(midx, midy, target._z)) {
 					// check land
-					if (si->_flags & landmask && ib._z + ib._zd > landz) {
+					if (flags & landmask && ib._z + ib._zd > landz) {
 						info.land = item;
 						landz = ib._z + ib._zd;
 					}
@@ -824,20 +955,23 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			for (const auto *citem : _items[cx][cy]) {
-				if (citem->getObjId() == item->getObjId())
-					continue;
-				if (citem->hasExtFlags(Item::EXT_SPRITE))
+			const ChunkBoxes *boxes = _boxes[cx][cy];
+			if (!boxes)
+				continue;
+
+			for (uint b = 0; b < boxes->size(); b++) {
+				if (boxes->_objId[b] == item->getObjId())
 					continue;
 
-				const ShapeInfo *si = citem->getShapeInfo();
+				const uint32 flags = boxes->_shapeFlags[b];
 				//!! need to check is_sea() and is_land() maybe?
-				if (!(si->_flags & blockflagmask))
+				if (!(flags & blockflagmask))
 					continue; // not an interesting item
 
-				int32 ixd, iyd, izd;
-				Point3 pt = citem->getLocation();
-				citem->getFootpadWorld(ixd, iyd, izd);
+				const Point3 pt(boxes->_x[b], boxes->_y[b], boxes->_z[b]);
+				const int32 ixd = boxes->_xd[b];
+				const int32 iyd = boxes->_yd[b];
+				const int32 izd = boxes->_zd[b];
 
 				int minv = pt.z - z - zd + 1;
 				int maxv = pt.z + izd - z - 1;
@@ -876,7 +1010,7 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 					for (int i = minh; i <= maxh; ++i)
 						validmask[j + scansize] &= ~(1 << (i + scansize));
 
-				if (wantsupport && si->is_solid() &&
+				if (wantsupport && (flags & ShapeInfo::SI_SOLID) &&
 				        pt.z + izd >= z - scansize && pt.z + izd <= z + scansize) {
 					for (int i = minh; i <= maxh; ++i)
 						supportmask[pt.z + izd - z + scansize] |= (1 << (i + scansize));
@@ -1006,13 +1140,16 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			for (const auto *other_item : _items[cx][cy]) {
-				if (other_item->getObjId() == item)
-					continue;
-				if (other_item->hasExtFlags(Item::EXT_SPRITE))
+			const ChunkBoxes *boxes = _boxes[cx][cy];
+			if (!boxes)
+				continue;
+
+			for (uint b = 0; b < boxes->size(); b++) {
+				const ObjId other_id = boxes->_objId[b];
+				if (other_id == item)
 					continue;
 
-				uint32 othershapeflags = other_item->getShapeInfo()->_flags;
+				uint32 othershapeflags = boxes->_shapeFlags[b];
 				bool blocking = (othershapeflags & shapeflags &
 				                 blockflagmask) != 0;
 
@@ -1022,11 +1159,12 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 					continue;
 
 				int32 other[3], oext[3];
-				Point3 opt = other_item->getLocation();
-				other[0] = opt.x;
-				other[1] = opt.y;
-				other[2] = opt.z;
-				other_item->getFootpadWorld(oext[0], oext[1], oext[2]);
+				other[0] = boxes->_x[b];
+				other[1] = boxes->_y[b];
+				other[2] = boxes->_z[b];
+				oext[0] = boxes->_xd[b];
+				oext[1] = boxes->_yd[b];
+				oext[2] = boxes->_zd[b];
 
 				// If the objects overlapped at the start, ignore collision.
 				// The -1 and +1 portions are to still consider collisions
@@ -1167,10 +1305,10 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 					}
 
 					// Now add it
-					hit->insert(sw_it, SweepItem(other_item->getObjId(), first, last, touch, touch_floor, blocking, dirs));
+					hit->insert(sw_it, SweepItem(other_id, first, last, touch, touch_floor, blocking, dirs));
 
 					//debugC(kDebugCollision, "Hit item %u (%d, %d, %d) at first: %d, last: %d",
-					//	   other_item->getObjId(), other[0], other[1], other[2], first, last);
+					//	   other_id, other[0], other[1], other[2], first, last);
 					//debugC(kDebugCollision, "hit item time (%d-%d) (%d-%d) (%d-%d)",
 					//	u_0[0], u_1[0], u_0[1], u_1[1], u_0[2], u_1[2]);
 					//debugC(kDebugCollision, "touch: %d, floor: %d, block: %d", touch, touch_floor, blocking);
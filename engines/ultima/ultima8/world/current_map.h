@@ -73,6 +73,10 @@ public:
 	void removeItemFromList(Item *item, int32 oldx, int32 oldy);
 	void removeItem(Item *item);
 
+	//! Refresh the stored box of an item after it moved within the map or
+	//! changed shape
+	void updateItemBox(const Item *item);
+
 	//! Add an item to the list of possible targets (in Crusader)
 	void addTargetItem(const Item *item);
 	//! Remove an item from the list of possible targets (in Crusader)
@@ -205,6 +209,37 @@ private:
 	// items[x][y]
 	Std::list<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
 
+	//! World boxes of the non-sprite items of a chunk, in no particular
+	//! order. Each item knows its slot. Collision queries scan these packed
+	//! arrays instead of fetching the shape info and location of every item.
+	struct ChunkBoxes {
+		Std::vector<Item *> _item;
+		Std::vector<ObjId> _objId;
+		Std::vector<uint32> _shapeFlags;
+		Std::vector<int32> _x, _y, _z;
+		Std::vector<int32> _xd, _yd, _zd;
+
+		uint size() const {
+			return _item.size();
+		}
+
+		Box getBox(uint index) const;
+
+		//! Append the box of an item and return its slot
+		uint add(Item *item);
+		void update(uint index, const Item *item);
+		//! Move the last box into the given slot. Returns the item it
+		//! belongs to, or nullptr if the last box was removed.
+		Item *remove(uint index);
+	};
+
+	// boxes[x][y], allocated when the first item gets added to the chunk
+	ChunkBoxes *_boxes[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+
+	void addItemBox(Item *item, int32 cx, int32 cy);
+	void removeItemBox(Item *item);
+	void clearItemBoxes();
+
 	ProcId _eggHatcher;
 
 	// Fast area bit masks -> fast[ry][rx/32]&(1<<(rx&31));
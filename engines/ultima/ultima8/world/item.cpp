@@ -79,7 +79,8 @@ Item::Item()
 	  _extendedFlags(0), _parent(0),
 	  _cachedShape(nullptr), _cachedShapeInfo(nullptr),
 	  _gump(0), _bark(0), _gravityPid(0), _lastSetup(0),
-	  _ix(0), _iy(0), _iz(0), _damagePoints(1) {
+	  _ix(0), _iy(0), _iz(0), _damagePoints(1),
+	  _mapBoxChunk(0), _mapBoxIndex(-1) {
 }
 
 
@@ -150,12 +151,21 @@ void Item::setLocation(int32 X, int32 Y, int32 Z) {
 	_x = X;
 	_y = Y;
 	_z = Z;
+	updateMapBox();
 }
 
 void Item::setLocation(const Point3 &pt) {
 	_x = pt.x;
 	_y = pt.y;
 	_z = pt.z;
+	updateMapBox();
+}
+
+void Item::updateMapBox() {
+	// Items keep their map chunk when moved directly, so only the packed
+	// box needs refreshing
+	if (_extendedFlags & EXT_INCURMAP)
+		World::get_instance()->getCurrentMap()->updateItemBox(this);
 }
 
 void Item::move(const Point3 &pt) {
@@ -224,6 +234,8 @@ void Item::move(int32 X, int32 Y, int32 Z) {
 			map->addItemToEnd(this);
 		else
 			map->addItem(this);
+	} else {
+		map->updateItemBox(this);
 	}
 
 	// Call just moved
@@ -489,6 +501,7 @@ void Item::setShape(uint32 shape) {
 		const ShapeInfo *oldinfo = getShapeInfo();
 		_shape = shape;
 		_cachedShapeInfo = nullptr;
+		updateMapBox();
 		const ShapeInfo *newinfo = getShapeInfo();
 
 		if (!hasFlags(FLG_BROKEN) && oldinfo && newinfo) {
@@ -502,6 +515,7 @@ void Item::setShape(uint32 shape) {
 	} else {
 		_shape = shape;
 		_cachedShapeInfo = nullptr;
+		updateMapBox();
 	}
 }
 
@@ -3022,6 +3036,8 @@ uint32 Item::I_andStatus(const uint8 *args, unsigned int argsize) {
 	if (!item) return 0;
 
 	item->_flags &= mask;
+	if (!(mask & FLG_FLIPPED))
+		item->updateMapBox();
 	return 0;
 }
 
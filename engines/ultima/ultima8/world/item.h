@@ -41,6 +41,7 @@ class GravityProcess;
 
 class Item : public Object {
 	friend class ItemFactory;
+	friend class CurrentMap;
 
 public:
 	Item();
@@ -111,6 +112,7 @@ public:
 	//! Set this Item's Z coordinate
 	void setZ(int32 z) {
 		_z = z;
+		updateMapBox();
 	}
 
 	//! Get this Item's location in a ContainerGump. Undefined if the Item
@@ -153,6 +155,8 @@ public:
 	//! Set the flags set in the given mask.
 	void setFlag(uint32 mask) {
 		_flags |= mask;
+		if (mask & FLG_FLIPPED)
+			updateMapBox();
 	}
 
 	virtual void setFlagRecursively(uint32 mask) {
@@ -162,6 +166,8 @@ public:
 	//! Clear the flags set in the given mask.
 	void clearFlag(uint32 mask) {
 		_flags &= ~mask;
+		if (mask & FLG_FLIPPED)
+			updateMapBox();
 	}
 
 	//! Set _extendedFlags
@@ -649,6 +655,14 @@ protected:
 
 	uint8 _damagePoints;	// Damage points, used for item damage in Crusader
 
+	// Where the CurrentMap keeps the packed box of this item: the chunk
+	// (x * MAP_NUM_CHUNKS + y) and the slot in it, or -1 if there is none
+	uint16 _mapBoxChunk;
+	int32 _mapBoxIndex;
+
+	//! Let the CurrentMap know that the world box of this item changed
+	void updateMapBox();
+
 	//! True if this is a Robot shape (in a fixed list)
 	bool isRobotCru() const;
 
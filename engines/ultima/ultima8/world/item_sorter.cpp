@@ -46,46 +46,21 @@ static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
 ItemSorter::ItemSorter(int capacity) :
-	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
+	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _list(capacity),
+	_painted(nullptr), _camSx(0), _camSy(0),
 	_sortLimit(0), _sortLimitChanged(false) {
-	int i = capacity;
-	while (i--) {
-		SortItem *next = _itemsUnused;
-		_itemsUnused = new SortItem();
-		_itemsUnused->_next = next;
-	}
-}
-
-ItemSorter::~ItemSorter() {
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-	_items = nullptr;
-	_itemsTail = nullptr;
-
-	while (_itemsUnused) {
-		SortItem *next = _itemsUnused->_next;
-		delete _itemsUnused;
-		_itemsUnused = next;
-	}
 }
 
 void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	// Get the _shapes, if required
 	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
 
-	// Set the clip window, and reset the item list
-	_clipWindow = clipWindow;
-
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+	// Painting changes the occlusion, so the list can't be kept
+	_list.clear();
+#endif
 
-	_items = nullptr;
-	_itemsTail = nullptr;
+	_list.begin();
 	_painted = nullptr;
 
 	// Screenspace bounding box bottom x coord (RNB x coord)
@@ -100,14 +75,18 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 		// Reset sort limit debugging on camera move
 		_sortLimit = 0;
 	}
+
+	// Sort items keep screen coordinates without the camera offset, so
+	// that they can be kept while the camera scrolls. Move the clip window
+	// there instead.
+	_clipWindow = clipWindow;
+	_clipWindow.translate(_camSx, _camSy);
 }
 
 void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
 
 	// First thing, get a SortItem to use (first of unused)
-	if (!_itemsUnused)
-		_itemsUnused = new SortItem();
-	SortItem *si = _itemsUnused;
+	SortItem *si = _list.getUnused();
 
 	si->_itemNum = itemNum;
 	si->_shape = _shapes->getShape(shapeNum);
@@ -136,7 +115,7 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 
 	// Worldspace bounding box
 	Box box(pt.x, pt.y, pt.z, xd, yd, zd);
-	si->setBoxBounds(box, _camSx, _camSy);
+	si->setBoxBounds(box, 0, 0);
 
 	// Real Screenspace from shape frame
 	if (si->_flags & Item::FLG_FLIPPED) {
@@ -179,94 +158,8 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 		si->_invitem = info->is_invitem();
 	}
 
-	si->_occluded = false;
-	si->_order = -1;
-
-	// We will clear all the vector memory
-	// Stictly speaking the vector will sort of leak memory, since they
-	// are never deleted
-	si->_depends.clear();
-
-	// Iterate the list and compare _shapes
-
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
-
-		if (si2->_occluded)
-			continue;
-
-#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
-		// Find adjoining rects for better occlusion
-		if (si->_occl && si2->_occl && si->_z == si2->_z) {
-			// Does this share an edge?
-			if (si->_y == si2->_y && si->_yFar == si2->_yFar) {
-				if (si->_xLeft == si2->_x) {
-					si->_xAdjoin = si2;
-				} else if (si->_x == si2->_xLeft) {
-					si2->_xAdjoin = si;
-				}
-			}
-			else if (si->_x == si2->_x && si->_xLeft == si2->_xLeft) {
-				if (si->_yFar == si2->_y) {
-					si->_yAdjoin = si2;
-				} else if (si->_y == si2->_yFar) {
-					si2->_yAdjoin = si;
-				}
-			}
-		}
-#endif // SORTITEM_OCCLUSION_EXPERIMENTAL
-
-		// Attempt to find paint dependency order
-		if (si->overlap(*si2)) {
-			if (si->below(*si2)) {
-				if (si2->_occl && si2->occludes(*si)) {
-					// No need to do any more checks, this isn't visible
-					si->_occluded = true;
-					break;
-				} else {
-					// si1 is behind si2, so add it to si2's dependency list
-					si2->_depends.insert_sorted(si);
-				}
-			} else {
-				if (si->_occl && si->occludes(*si2)) {
-					// Occluded, but we can't remove it from the list
-					si2->_occluded = true;
-				} else {
-					// si2 is behind si1, so add it to si1's dependency list
-					si->_depends.insert_sorted(si2);
-				}
-			}
-		}
-	}
-
-	// Add it to the list
-	_itemsUnused = _itemsUnused->_next;
-
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
-	}
+	// Keeps the dependencies from the previous frame if nothing changed
+	_list.add(si);
 }
 
 void ItemSorter::AddItem(const Item *add) {
@@ -275,19 +168,23 @@ void ItemSorter::AddItem(const Item *add) {
 }
 
 void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool showFootpads, int gridlines) {
+	_list.end();
+
 	if (_sortLimit) {
 		// Clear the surface when debugging the sorter
 		uint32 color = TEX32_PACK_RGB(0, 0, 0);
-		surf->fill32(color, _clipWindow);
+		Rect r = _clipWindow;
+		r.translate(-_camSx, -_camSy);
+		surf->fill32(color, r);
 	}
 
 #ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
-	int32 minZ = _items ? _items->_z : 0;
+	int32 minZ = _list.getItems() ? _list.getItems()->_z : 0;
 
 	// Reverse iterate to check higher z items first.
 	// This increases odds of occluding items below before checking them.
 	// Ignore items already occluded or at lowest Z as they are less likely occlude additional items.
-	for (SortItem *si1 = _itemsTail; si1 != nullptr; si1 = si1->_prev) {
+	for (SortItem *si1 = _list.getItemsTail(); si1 != nullptr; si1 = si1->_prev) {
 		// Check if item is part of a 2x2 rects square
 		if (si1->_occl && !si1->_occluded && si1->_z > minZ &&
 			si1->_xAdjoin && si1->_yAdjoin &&
@@ -352,9 +249,9 @@ void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool
 				// Use min z top to avoid wrong occlusions caused by different heights
 				box._zd = zTop - box._z;
 
-				oc.setBoxBounds(box, _camSx, _camSy);
+				oc.setBoxBounds(box, 0, 0);
 
-				for (si2 = _items; si2 != nullptr; si2 = si2->_next) {
+				for (si2 = _list.getItems(); si2 != nullptr; si2 = si2->_next) {
 					if (si2->_groupNum != group && !si2->_occluded &&
 						si2->overlap(oc) && si2->below(oc) && oc.occludes(*si2)) {
 						si2->_occluded = true;
@@ -365,7 +262,7 @@ void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool
 	}
 #endif
 
-	SortItem *it = _items;
+	SortItem *it = _list.getItems();
 	SortItem *end = nullptr;
 	_painted = nullptr;  // Reset the paint tracking
 	while (it != end) {
@@ -377,13 +274,13 @@ void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool
 
 	// Item highlighting. We redraw each 'item' transparent
 	if (item_highlight) {
-		it = _items;
+		it = _list.getItems();
 		while (it != end) {
 			if (!(it->_flags & (Item::FLG_DISPOSABLE | Item::FLG_FAST_ONLY)) && !it->_fixed) {
 				surf->PaintHighlightInvis(it->_shape,
 				                          it->_frame,
-				                          it->_sxBot,
-				                          it->_syBot,
+				                          it->_sxBot - _camSx,
+				                          it->_syBot - _camSy,
 				                          it->_trans,
 				                          (it->_flags & Item::FLG_FLIPPED) != 0,
 										  HIGHLIGHT_COLOR);
@@ -424,16 +321,20 @@ bool ItemSorter::PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootp
 
 	// Now paint us!
 	if (surf) {
+		// Apply the camera offset
+		const int32 sxBot = si->_sxBot - _camSx;
+		const int32 syBot = si->_syBot - _camSy;
+
 		if (si->_extFlags & Item::EXT_HIGHLIGHT && si->_extFlags & Item::EXT_TRANSPARENT)
-			surf->PaintHighlightInvis(si->_shape, si->_frame, si->_sxBot, si->_syBot, si->_trans, (si->_flags & Item::FLG_FLIPPED) != 0, TRANSPARENT_COLOR);
+			surf->PaintHighlightInvis(si->_shape, si->_frame, sxBot, syBot, si->_trans, (si->_flags & Item::FLG_FLIPPED) != 0, TRANSPARENT_COLOR);
 		if (si->_extFlags & Item::EXT_HIGHLIGHT)
-			surf->PaintHighlight(si->_shape, si->_frame, si->_sxBot, si->_syBot, si->_trans, (si->_flags & Item::FLG_FLIPPED) != 0, TRANSPARENT_COLOR);
+			surf->PaintHighlight(si->_shape, si->_frame, sxBot, syBot, si->_trans, (si->_flags & Item::FLG_FLIPPED) != 0, TRANSPARENT_COLOR);
 		else if (si->_extFlags & Item::EXT_TRANSPARENT)
-			surf->PaintInvisible(si->_shape, si->_frame, si->_sxBot, si->_syBot, si->_trans, (si->_flags & Item::FLG_FLIPPED) != 0);
+			surf->PaintInvisible(si->_shape, si->_frame, sxBot, syBot, si->_trans, (si->_flags & Item::FLG_FLIPPED) != 0);
 		else if (si->_trans)
-			surf->PaintTranslucent(si->_shape, si->_frame, si->_sxBot, si->_syBot, (si->_flags & Item::FLG_FLIPPED) != 0);
+			surf->PaintTranslucent(si->_shape, si->_frame, sxBot, syBot, (si->_flags & Item::FLG_FLIPPED) != 0);
 		else
-			surf->Paint(si->_shape, si->_frame, si->_sxBot, si->_syBot, (si->_flags & Item::FLG_FLIPPED) != 0);
+			surf->Paint(si->_shape, si->_frame, sxBot, syBot, (si->_flags & Item::FLG_FLIPPED) != 0);
 
 		// Draw wire frame footpads
 		if (showFootpad) {
@@ -444,19 +345,24 @@ bool ItemSorter::PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootp
 			int32 syRightTop = si->_x / 8 + si->_yFar / 8 - si->_zTop - _camSy;
 			int32 syNearTop = si->_x / 8 + si->_y / 8 - si->_zTop - _camSy;
 
-			surf->drawLine32(color, si->_sxTop, si->_syTop, si->_sxLeft, syLeftTop);
-			surf->drawLine32(color, si->_sxTop, si->_syTop, si->_sxRight, syRightTop);
-			surf->drawLine32(color, si->_sxBot, syNearTop, si->_sxLeft, syLeftTop);
-			surf->drawLine32(color, si->_sxBot, syNearTop, si->_sxRight, syRightTop);
+			const int32 sxLeft = si->_sxLeft - _camSx;
+			const int32 sxRight = si->_sxRight - _camSx;
+			const int32 sxTop = si->_sxTop - _camSx;
+			const int32 syTop = si->_syTop - _camSy;
+
+			surf->drawLine32(color, sxTop, syTop, sxLeft, syLeftTop);
+			surf->drawLine32(color, sxTop, syTop, sxRight, syRightTop);
+			surf->drawLine32(color, sxBot, syNearTop, sxLeft, syLeftTop);
+			surf->drawLine32(color, sxBot, syNearTop, sxRight, syRightTop);
 
 			if (si->_z < si->_zTop) {
 				int32 syLeftBot = si->_xLeft / 8 + si->_y / 8 - si->_z - _camSy;
 				int32 syRightBot = si->_x / 8 + si->_yFar / 8 - si->_z - _camSy;
-				surf->drawLine32(color, si->_sxLeft, syLeftTop, si->_sxLeft, syLeftBot);
-				surf->drawLine32(color, si->_sxRight, syRightTop, si->_sxRight, syRightBot);
-				surf->drawLine32(color, si->_sxBot, syNearTop, si->_sxBot, si->_syBot);
-				surf->drawLine32(color, si->_sxLeft, syLeftBot, si->_sxBot, si->_syBot);
-				surf->drawLine32(color, si->_sxRight, syRightBot, si->_sxBot, si->_syBot);
+				surf->drawLine32(color, sxLeft, syLeftTop, sxLeft, syLeftBot);
+				surf->drawLine32(color, sxRight, syRightTop, sxRight, syRightBot);
+				surf->drawLine32(color, sxBot, syNearTop, sxBot, syBot);
+				surf->drawLine32(color, sxLeft, syLeftBot, sxBot, syBot);
+				surf->drawLine32(color, sxRight, syRightBot, sxBot, syBot);
 			}
 		}
 
@@ -507,8 +413,8 @@ bool ItemSorter::PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootp
 			if (wo_frame) {
 				const Shape *wo_shape = GameData::get_instance()->getMainShapes()->getShape(wo_shapenum);
 				surf->Paint(wo_shape, wo_frame->_frame,
-							si->_sxBot + wo_frame->_xOff,
-							si->_syBot + wo_frame->_yOff, false);
+							sxBot + wo_frame->_xOff,
+							syBot + wo_frame->_yOff, false);
 			}
 		}
 	}
@@ -541,8 +447,14 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	_list.end();
+
+	// Sort items are in screen space without the camera offset
+	x += _camSx;
+	y += _camSy;
+
 	if (!_painted) { // If no painted item found, we need to sort the items
-		it = _items;
+		it = _list.getItems();
 		_painted = nullptr;
 		while (it != nullptr) {
 			if (it->_order == -1)
@@ -559,7 +471,7 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	if (item_highlight) {
 		selected = nullptr;
 
-		for (it = _itemsTail; it != nullptr; it = it->_prev) {
+		for (it = _list.getItemsTail(); it != nullptr; it = it->_prev) {
 			if (!(it->_flags & (Item::FLG_DISPOSABLE | Item::FLG_FAST_ONLY)) && !it->_fixed) {
 				if (!it->_itemNum || !it->contains(x, y))
 					continue;
@@ -591,7 +503,7 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	// Finally we then set the selected SortItem if it's '_order' is highest
 
 	if (!selected) {
-		for (it = _items; it != nullptr; it = it->_next) {
+		for (it = _list.getItems(); it != nullptr; it = it->_next) {
 			if (!it->_itemNum || !it->contains(x, y))
 				continue;
 
@@ -23,6 +23,7 @@
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
 #include "ultima/ultima8/misc/rect.h"
+#include "ultima/ultima8/world/sort_item_list.h"
 
 namespace Ultima {
 namespace Ultima8 {
@@ -35,11 +36,9 @@ struct Point3;
 
 class ItemSorter {
 	MainShapeArchive    *_shapes;
-	Rect        _clipWindow;
+	Rect        _clipWindow;    // In screen space without the camera offset
 
-	SortItem    *_items;
-	SortItem    *_itemsTail;
-	SortItem    *_itemsUnused;
+	SortItemList _list;
 	SortItem    *_painted;
 
 	int32       _camSx, _camSy;
@@ -48,7 +47,6 @@ class ItemSorter {
 
 public:
 	ItemSorter(int capacity);
-	~ItemSorter();
 
 	enum HitFace {
 		X_FACE, Y_FACE, Z_FACE
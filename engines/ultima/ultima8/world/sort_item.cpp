@@ -61,6 +61,25 @@ void SortItem::setBoxBounds(const Box& box, int32 sx, int32 sy) {
 	_flat = box._zd == 0;
 }
 
+bool SortItem::sameAs(const SortItem &si2) const {
+	return _itemNum == si2._itemNum && _shape == si2._shape &&
+		   _shapeNum == si2._shapeNum && _frame == si2._frame &&
+		   _flags == si2._flags && _extFlags == si2._extFlags &&
+		   _sr == si2._sr &&
+		   _x == si2._x && _y == si2._y && _z == si2._z &&
+		   _xLeft == si2._xLeft && _yFar == si2._yFar && _zTop == si2._zTop &&
+		   _sxLeft == si2._sxLeft && _sxRight == si2._sxRight &&
+		   _sxTop == si2._sxTop && _syTop == si2._syTop &&
+		   _sxBot == si2._sxBot && _syBot == si2._syBot &&
+		   _fbigsq == si2._fbigsq && _flat == si2._flat &&
+		   _occl == si2._occl && _solid == si2._solid &&
+		   _draw == si2._draw && _roof == si2._roof &&
+		   _noisy == si2._noisy && _anim == si2._anim &&
+		   _trans == si2._trans && _fixed == si2._fixed &&
+		   _land == si2._land && _sprite == si2._sprite &&
+		   _invitem == si2._invitem;
+}
+
 bool SortItem::below(const SortItem &si2) const {
 	const SortItem &si1 = *this;
 
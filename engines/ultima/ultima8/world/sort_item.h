@@ -208,6 +208,21 @@ struct SortItem {
 			tail = nn;
 		}
 
+		void remove(SortItem *other) {
+			for (Node *n = list; n != nullptr; n = n->_next) {
+				if (n->val == other) {
+					if (n->_prev) n->_prev->_next = n->_next;
+					else list = n->_next;
+					if (n->_next) n->_next->_prev = n->_prev;
+					else tail = n->_prev;
+
+					n->_next = unused;
+					unused = n;
+					return;
+				}
+			}
+		}
+
 		DependsList() : list(nullptr), tail(nullptr), unused(nullptr) { }
 
 		~DependsList() {
@@ -251,6 +266,10 @@ struct SortItem {
 	// Screenspace check to see if this is below si2. Assumes this overlaps si2
 	bool below(const SortItem &si2) const;
 
+	// Check if this has the same shape, position and flags as si2, ignoring
+	// the list links, dependencies and painting state
+	bool sameAs(const SortItem &si2) const;
+
 	// Comparison for the sorted lists
 	inline bool listLessThan(const SortItem &si2) const {
 		const SortItem &si1 = *this;
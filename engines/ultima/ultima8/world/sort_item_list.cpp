@@ -0,0 +1,227 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "ultima/ultima8/world/sort_item_list.h"
+#include "ultima/ultima8/world/sort_item.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+SortItemList::SortItemList(int capacity) :
+	_items(nullptr), _itemsTail(nullptr), _itemsUnused(nullptr), _reused(0) {
+	int i = capacity;
+	while (i--) {
+		SortItem *next = _itemsUnused;
+		_itemsUnused = new SortItem();
+		_itemsUnused->_next = next;
+	}
+}
+
+SortItemList::~SortItemList() {
+	clear();
+
+	while (_itemsUnused) {
+		SortItem *next = _itemsUnused->_next;
+		delete _itemsUnused;
+		_itemsUnused = next;
+	}
+}
+
+void SortItemList::begin() {
+	_reused = 0;
+
+	// Kept items need painting again
+	for (SortItem *si = _items; si != nullptr; si = si->_next)
+		si->_order = -1;
+}
+
+SortItem *SortItemList::getUnused() {
+	if (!_itemsUnused)
+		_itemsUnused = new SortItem();
+	return _itemsUnused;
+}
+
+void SortItemList::add(SortItem *si) {
+	assert(si == _itemsUnused);
+
+	if (_reused < _added.size()) {
+		if (_added[_reused]._item->sameAs(*si)) {
+			// Same as in the previous frame, so keep that one instead
+			_reused++;
+			return;
+		}
+
+		// Take the item before the discarded ones get back to the unused list
+		_itemsUnused = si->_next;
+		discard(_reused);
+	} else {
+		_itemsUnused = si->_next;
+	}
+
+	AddedItem added;
+	added._item = si;
+	added._dependsStart = _addedDepends.size();
+	added._occludedStart = _addedOccluded.size();
+
+	si->_occluded = false;
+	si->_order = -1;
+
+	// We will clear all the vector memory
+	// Stictly speaking the vector will sort of leak memory, since they
+	// are never deleted
+	si->_depends.clear();
+
+	// Iterate the list and compare _shapes
+
+	// Ok,
+	SortItem *addpoint = nullptr;
+	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
+		// Get the insert point... which is before the first item that has higher z than us
+		if (!addpoint && si->listLessThan(*si2))
+			addpoint = si2;
+
+		if (si2->_occluded)
+			continue;
+
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+		// Find adjoining rects for better occlusion
+		if (si->_occl && si2->_occl && si->_z == si2->_z) {
+			// Does this share an edge?
+			if (si->_y == si2->_y && si->_yFar == si2->_yFar) {
+				if (si->_xLeft == si2->_x) {
+					si->_xAdjoin = si2;
+				} else if (si->_x == si2->_xLeft) {
+					si2->_xAdjoin = si;
+				}
+			}
+			else if (si->_x == si2->_x && si->_xLeft == si2->_xLeft) {
+				if (si->_yFar == si2->_y) {
+					si->_yAdjoin = si2;
+				} else if (si->_y == si2->_yFar) {
+					si2->_yAdjoin = si;
+				}
+			}
+		}
+#endif // SORTITEM_OCCLUSION_EXPERIMENTAL
+
+		// Attempt to find paint dependency order
+		if (si->overlap(*si2)) {
+			if (si->below(*si2)) {
+				if (si2->_occl && si2->occludes(*si)) {
+					// No need to do any more checks, this isn't visible
+					si->_occluded = true;
+					break;
+				} else {
+					// si1 is behind si2, so add it to si2's dependency list
+					si2->_depends.insert_sorted(si);
+					_addedDepends.push_back(si2);
+				}
+			} else {
+				if (si->_occl && si->occludes(*si2)) {
+					// Occluded, but we can't remove it from the list
+					si2->_occluded = true;
+					_addedOccluded.push_back(si2);
+				} else {
+					// si2 is behind si1, so add it to si1's dependency list
+					si->_depends.insert_sorted(si2);
+				}
+			}
+		}
+	}
+
+	// have a position
+	//addpoint = 0;
+	if (addpoint) {
+		si->_next = addpoint;
+		si->_prev = addpoint->_prev;
+		addpoint->_prev = si;
+		if (si->_prev)
+			si->_prev->_next = si;
+		else
+			_items = si;
+	}
+	// Add it to the end of the list
+	else {
+		if (_itemsTail)
+			_itemsTail->_next = si;
+		if (!_items)
+			_items = si;
+		si->_next = nullptr;
+		si->_prev = _itemsTail;
+		_itemsTail = si;
+	}
+
+	_added.push_back(added);
+	_reused = _added.size();
+}
+
+void SortItemList::end() {
+	discard(_reused);
+}
+
+void SortItemList::clear() {
+	if (_itemsTail) {
+		_itemsTail->_next = _itemsUnused;
+		_itemsUnused = _items;
+	}
+
+	_items = nullptr;
+	_itemsTail = nullptr;
+
+	_added.clear();
+	_addedDepends.clear();
+	_addedOccluded.clear();
+	_reused = 0;
+}
+
+void SortItemList::discard(uint count) {
+	// Undo in reverse order, so each item sees the list as it was after adding it
+	while (_added.size() > count) {
+		const AddedItem &added = _added.back();
+		SortItem *si = added._item;
+
+		for (uint i = added._dependsStart; i < _addedDepends.size(); i++)
+			_addedDepends[i]->_depends.remove(si);
+		for (uint i = added._occludedStart; i < _addedOccluded.size(); i++)
+			_addedOccluded[i]->_occluded = false;
+
+		_addedDepends.resize(added._dependsStart);
+		_addedOccluded.resize(added._occludedStart);
+
+		if (si->_prev)
+			si->_prev->_next = si->_next;
+		else
+			_items = si->_next;
+		if (si->_next)
+			si->_next->_prev = si->_prev;
+		else
+			_itemsTail = si->_prev;
+
+		si->_next = _itemsUnused;
+		_itemsUnused = si;
+
+		_added.pop_back();
+	}
+}
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
@@ -0,0 +1,99 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef ULTIMA8_WORLD_SORTITEMLIST_H
+#define ULTIMA8_WORLD_SORTITEMLIST_H
+
+#include "ultima/shared/std/containers.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+struct SortItem;
+
+/**
+ * The list of sort items in a display list and their paint dependencies.
+ *
+ * The list is kept from one frame to the next. Items are expected to be added
+ * in the same order every frame, and as long as they are the same as the items
+ * added in the previous frame, the dependencies found for those are kept. The
+ * first item that differs undoes everything the previous frame added after it,
+ * so the result is always the same as that of sorting the whole list again.
+ *
+ * This class is basically private to ItemSorter, but is separate from it
+ * to enable unit testing.
+ */
+class SortItemList {
+	SortItem    *_items;
+	SortItem    *_itemsTail;
+	SortItem    *_itemsUnused;
+
+	// What adding an item changed in the list, so it can be undone
+	struct AddedItem {
+		SortItem *_item;
+		uint _dependsStart;  // First entry in _addedDepends
+		uint _occludedStart; // First entry in _addedOccluded
+	};
+
+	Std::vector<AddedItem> _added;
+	Std::vector<SortItem *> _addedDepends;  // Items that got an added item as dependency
+	Std::vector<SortItem *> _addedOccluded; // Items that got occluded by an added item
+
+	// Number of entries in _added that are used by the current frame
+	uint _reused;
+
+	// Undo the changes of all but the first count entries in _added
+	void discard(uint count);
+
+public:
+	SortItemList(int capacity);
+	~SortItemList();
+
+	SortItem *getItems() const {
+		return _items;
+	}
+
+	SortItem *getItemsTail() const {
+		return _itemsTail;
+	}
+
+	// Start matching items against the current list
+	void begin();
+
+	// Get an unused item to set up and add
+	SortItem *getUnused();
+
+	// Add an item set up after getUnused(). The item returned by the next
+	// getUnused() call may be another one.
+	void add(SortItem *si);
+
+	// Remove the items of the previous frame that were not added again
+	void end();
+
+	// Remove all items
+	void clear();
+};
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
+
+#endif
@@ -30,6 +30,7 @@ struct Point;
 }
 
 class BlendBlitUnfilteredTestSuite;
+class BlitSIMDTestSuite;
 
 namespace Graphics {
 
@@ -217,6 +218,24 @@ typedef void (*FastBlitFunc)(byte *, const byte *, const uint, const uint, const
 void fastBlitNEON_XRGB1555_RGB565(byte *, const byte *, const uint, const uint, const uint, const uint);
 #endif
 
+#ifdef SCUMMVM_SSE2
+// Fast blit functions for x86 SSE2
+void fastBlitSSE2_RGB565_XRGB8888(byte *, const byte *, const uint, const uint, const uint, const uint);
+void fastBlitSSE2_RGB565_ARGB8888(byte *, const byte *, const uint, const uint, const uint, const uint);
+void fastBlitSSE2_XRGB8888_RGB565(byte *, const byte *, const uint, const uint, const uint, const uint);
+template<bool bswap, int rotate>
+void fastBlitSSE2_swap(byte *, const byte *, const uint, const uint, const uint, const uint);
+#endif
+
+#ifdef SCUMMVM_AVX2
+// Fast blit functions for x86 AVX2
+void fastBlitAVX2_RGB565_XRGB8888(byte *, const byte *, const uint, const uint, const uint, const uint);
+void fastBlitAVX2_RGB565_ARGB8888(byte *, const byte *, const uint, const uint, const uint, const uint);
+void fastBlitAVX2_XRGB8888_RGB565(byte *, const byte *, const uint, const uint, const uint, const uint);
+template<bool bswap, int rotate>
+void fastBlitAVX2_swap(byte *, const byte *, const uint, const uint, const uint, const uint);
+#endif
+
 /**
  * Look up optimised routines for converting between pixel formats.
  *
@@ -322,6 +341,12 @@ private:
 	typedef void(*BlitFunc)(Args &, const TSpriteBlendMode &, const AlphaType &);
 	static BlitFunc blitFunc;
 
+#ifdef SCUMMVM_SSE2
+	static void fillSSE2(Args &args, const TSpriteBlendMode &blendMode);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void fillAVX2(Args &args, const TSpriteBlendMode &blendMode);
+#endif
 	static void fillGeneric(Args &args, const TSpriteBlendMode &blendMode);
 	template<class T>
 	static void fillT(Args &args, const TSpriteBlendMode &blendMode);
@@ -330,6 +355,7 @@ private:
 	static FillFunc fillFunc;
 
 	friend class ::BlendBlitUnfilteredTestSuite;
+	friend class ::BlitSIMDTestSuite;
 	friend class BlendBlitImpl_Default;
 	friend class BlendBlitImpl_NEON;
 	friend class BlendBlitImpl_SSE2;
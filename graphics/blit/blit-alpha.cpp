@@ -253,9 +253,14 @@ void BlendBlit::fill(byte *dst, const uint dstPitch,
 
 	// If no function has been selected yet, detect and select
 	if (!fillFunc) {
-		// Get the correct blit function
-		// TODO: Add SIMD variants
+		// Get the correct fill function
 		fillFunc = fillGeneric;
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) fillFunc = fillSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) fillFunc = fillAVX2;
+#endif
 	}
 
 	Args args(dst, nullptr, dstPitch, 0, 0, 0, width, height, 0, 0, 0, 0, colorMod, 0);
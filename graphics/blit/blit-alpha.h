@@ -27,6 +27,25 @@ class BlendBlitImpl_Base {
 	friend class BlendBlit;
 protected:
 
+/**
+ * Filling changes each channel of a pixel on its own, as
+ * ((x * mul + add) >> 8) + bias truncated to a byte, for all blend modes.
+ * The SIMD fills work from these coefficients.
+ */
+struct FillCoeffs {
+	uint16 mul[4], add[4], bias[4];
+
+	inline void set(int index, uint16 m, uint16 a, uint16 b) {
+		mul[index] = m;
+		add[index] = a;
+		bias[index] = b;
+	}
+
+	inline void keep(int index) {
+		set(index, 256, 0, 0);
+	}
+};
+
 template<bool rgbmod, bool alphamod>
 struct BaseBlend {
 public:
@@ -120,6 +139,21 @@ public:
 		}
 
 	}
+
+	inline void fillCoeffs(FillCoeffs &coeffs) const {
+		const uint ina = this->ca;
+
+		coeffs.set(BlendBlit::kAIndex, 0, 0, 255);
+		if (rgbmod) {
+			coeffs.set(BlendBlit::kBIndex, 255 - ina, 0, 255 * ina * this->cb >> 16);
+			coeffs.set(BlendBlit::kGIndex, 255 - ina, 0, 255 * ina * this->cg >> 16);
+			coeffs.set(BlendBlit::kRIndex, 255 - ina, 0, 255 * ina * this->cr >> 16);
+		} else {
+			coeffs.set(BlendBlit::kBIndex, 255 - ina, 255 * ina, 0);
+			coeffs.set(BlendBlit::kGIndex, 255 - ina, 255 * ina, 0);
+			coeffs.set(BlendBlit::kRIndex, 255 - ina, 255 * ina, 0);
+		}
+	}
 };
 
 template<bool rgbmod, bool alphamod>
@@ -180,6 +214,32 @@ public:
 			}
 		}
 	}
+
+	inline void fillCoeffs(FillCoeffs &coeffs) const {
+		const uint ina = this->ca;
+
+		coeffs.keep(BlendBlit::kAIndex);
+		coeffs.keep(BlendBlit::kBIndex);
+		coeffs.keep(BlendBlit::kGIndex);
+		coeffs.keep(BlendBlit::kRIndex);
+		if (ina == 255) {
+			if (rgbmod) {
+				coeffs.set(BlendBlit::kBIndex, this->cb, 0, 0);
+				coeffs.set(BlendBlit::kGIndex, this->cg, 0, 0);
+				coeffs.set(BlendBlit::kRIndex, this->cr, 0, 0);
+			}
+		} else if (ina != 0) {
+			if (rgbmod) {
+				coeffs.set(BlendBlit::kBIndex, (this->cb * ina) >> 8, 0, 0);
+				coeffs.set(BlendBlit::kGIndex, (this->cg * ina) >> 8, 0, 0);
+				coeffs.set(BlendBlit::kRIndex, (this->cr * ina) >> 8, 0, 0);
+			} else {
+				coeffs.set(BlendBlit::kBIndex, ina, 0, 0);
+				coeffs.set(BlendBlit::kGIndex, ina, 0, 0);
+				coeffs.set(BlendBlit::kRIndex, ina, 0, 0);
+			}
+		}
+	}
 };
 
 template<bool rgbmod, bool alphamod>
@@ -269,6 +329,24 @@ public:
 			}
 		}
 	}
+
+	inline void fillCoeffs(FillCoeffs &coeffs) const {
+		const uint ina = this->ca;
+
+		coeffs.keep(BlendBlit::kAIndex);
+		coeffs.keep(BlendBlit::kBIndex);
+		coeffs.keep(BlendBlit::kGIndex);
+		coeffs.keep(BlendBlit::kRIndex);
+		if (ina == 255) {
+			coeffs.set(BlendBlit::kBIndex, 256, 0, rgbmod ? this->cb : 255);
+			coeffs.set(BlendBlit::kGIndex, 256, 0, rgbmod ? this->cg : 255);
+			coeffs.set(BlendBlit::kRIndex, 256, 0, rgbmod ? this->cr : 255);
+		} else if (ina != 0) {
+			coeffs.set(BlendBlit::kBIndex, 256, 0, rgbmod ? ((this->cb * ina) >> 8) : ina);
+			coeffs.set(BlendBlit::kGIndex, 256, 0, rgbmod ? ((this->cg * ina) >> 8) : ina);
+			coeffs.set(BlendBlit::kRIndex, 256, 0, rgbmod ? ((this->cr * ina) >> 8) : ina);
+		}
+	}
 };
 
 template<bool rgbmod, bool alphamod>
@@ -316,6 +394,20 @@ public:
 			out[BlendBlit::kRIndex] = 0;
 		}
 	}
+
+	inline void fillCoeffs(FillCoeffs &coeffs) const {
+		coeffs.set(BlendBlit::kAIndex, 0, 0, 255);
+		if (rgbmod) {
+			// x - (x * c >> 8) is the same as (x * (256 - c) + 255) >> 8
+			coeffs.set(BlendBlit::kBIndex, 256 - this->cb, 255, 0);
+			coeffs.set(BlendBlit::kGIndex, 256 - this->cg, 255, 0);
+			coeffs.set(BlendBlit::kRIndex, 256 - this->cr, 255, 0);
+		} else {
+			coeffs.set(BlendBlit::kBIndex, 0, 0, 0);
+			coeffs.set(BlendBlit::kGIndex, 0, 0, 0);
+			coeffs.set(BlendBlit::kRIndex, 0, 0, 0);
+		}
+	}
 };
 
 }; // End of class BlendBlitImpl_Base
@@ -498,4 +590,18 @@ void BlendBlit::fillT(Args &args, const TSpriteBlendMode &blendMode) {
 	}
 }
 
+// Scalar versions of the fast pixel format conversions, for the pixels
+// left over by the SIMD loops. These match what crossBlit does.
+template<bool hasAlpha>
+static inline uint32 convertRGB565ToXRGB8888(uint16 col) {
+	const uint32 r = ColorComponent<5>::expand(col >> 11);
+	const uint32 g = ColorComponent<6>::expand(col >> 5);
+	const uint32 b = ColorComponent<5>::expand(col);
+	return (hasAlpha ? 0xFF000000 : 0) | (r << 16) | (g << 8) | b;
+}
+
+static inline uint16 convertXRGB8888ToRGB565(uint32 col) {
+	return ((col >> 8) & 0xF800) | ((col >> 5) & 0x07E0) | ((col >> 3) & 0x001F);
+}
+
 } // End of namespace Graphics
@@ -20,6 +20,7 @@
  */
 
 #include "common/scummsys.h"
+#include "common/endian.h"
 
 #include "graphics/blit/blit-alpha.h"
 #include "graphics/pixelformat.h"
@@ -315,12 +316,160 @@ static void blitInnerLoop(BlendBlit::Args &args) {
 	}
 }
 
+template<template <bool RGBMOD, bool ALPHAMOD> class PixelFunc, bool rgbmod, bool alphamod>
+static void fillInnerLoop(BlendBlit::Args &args) {
+	const PixelFunc<rgbmod, alphamod> pixelFunc(args.color);
+
+	FillCoeffs coeffs;
+	pixelFunc.fillCoeffs(coeffs);
+
+	const __m256i mul = _mm256_set1_epi64x((int64)coeffs.mul[0] | ((int64)coeffs.mul[1] << 16) | ((int64)coeffs.mul[2] << 32) | ((int64)coeffs.mul[3] << 48));
+	const __m256i add = _mm256_set1_epi64x((int64)coeffs.add[0] | ((int64)coeffs.add[1] << 16) | ((int64)coeffs.add[2] << 32) | ((int64)coeffs.add[3] << 48));
+	const __m256i bias = _mm256_set1_epi64x((int64)coeffs.bias[0] | ((int64)coeffs.bias[1] << 16) | ((int64)coeffs.bias[2] << 32) | ((int64)coeffs.bias[3] << 48));
+	const __m256i byteMask = _mm256_set1_epi16(0xFF);
+
+	for (uint32 i = 0; i < args.height; i++) {
+		byte *out = args.outo;
+
+		uint32 j = 0;
+		for (; j + 8 <= args.width; j += 8) {
+			const __m256i pixels = _mm256_loadu_si256((const __m256i *)out);
+			__m256i lo = _mm256_unpacklo_epi8(pixels, _mm256_setzero_si256());
+			__m256i hi = _mm256_unpackhi_epi8(pixels, _mm256_setzero_si256());
+			lo = _mm256_and_si256(_mm256_add_epi16(_mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(lo, mul), add), 8), bias), byteMask);
+			hi = _mm256_and_si256(_mm256_add_epi16(_mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(hi, mul), add), 8), bias), byteMask);
+			_mm256_storeu_si256((__m256i *)out, _mm256_packus_epi16(lo, hi));
+			out += 8 * 4;
+		}
+		for (; j < args.width; j++) {
+			pixelFunc.fill(out);
+			out += 4;
+		}
+		args.outo += args.dstPitch;
+	}
+}
+
 }; // end of class BlendBlitImpl_AVX2
 
 void BlendBlit::blitAVX2(Args &args, const TSpriteBlendMode &blendMode, const AlphaType &alphaType) {
 	blitT<BlendBlitImpl_AVX2>(args, blendMode, alphaType);
 }
 
+void BlendBlit::fillAVX2(Args &args, const TSpriteBlendMode &blendMode) {
+	fillT<BlendBlitImpl_AVX2>(args, blendMode);
+}
+
+template<bool hasAlpha>
+static void fastBlitAVX2_RGB565_8888(byte *dst, const byte *src,
+                                     const uint dstPitch, const uint srcPitch,
+                                     const uint w, const uint h) {
+	const __m256i alpha = _mm256_set1_epi16(hasAlpha ? (short)0xFF00 : 0);
+
+	// Converting from bottom right to top left allows converting in place
+	for (uint y = h; y-- > 0;) {
+		const uint16 *srcRow = (const uint16 *)(src + y * srcPitch);
+		uint32 *dstRow = (uint32 *)(dst + y * dstPitch);
+
+		uint x = w;
+		for (; x >= 16; x -= 16) {
+			const __m256i pixels = _mm256_loadu_si256((const __m256i *)(srcRow + x - 16));
+			__m256i r = _mm256_srli_epi16(pixels, 11);
+			__m256i g = _mm256_and_si256(_mm256_srli_epi16(pixels, 5), _mm256_set1_epi16(0x3F));
+			__m256i b = _mm256_and_si256(pixels, _mm256_set1_epi16(0x1F));
+			r = _mm256_or_si256(_mm256_slli_epi16(r, 3), _mm256_srli_epi16(r, 2));
+			g = _mm256_or_si256(_mm256_slli_epi16(g, 2), _mm256_srli_epi16(g, 4));
+			b = _mm256_or_si256(_mm256_slli_epi16(b, 3), _mm256_srli_epi16(b, 2));
+
+			const __m256i gb = _mm256_or_si256(_mm256_slli_epi16(g, 8), b);
+			const __m256i ar = _mm256_or_si256(alpha, r);
+			// The unpacking works on each 128-bit lane, so put the pixels back in order
+			const __m256i lo = _mm256_unpacklo_epi16(gb, ar);
+			const __m256i hi = _mm256_unpackhi_epi16(gb, ar);
+			_mm256_storeu_si256((__m256i *)(dstRow + x - 16), _mm256_permute2x128_si256(lo, hi, 0x20));
+			_mm256_storeu_si256((__m256i *)(dstRow + x - 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+		}
+		for (; x > 0; x--)
+			dstRow[x - 1] = convertRGB565ToXRGB8888<hasAlpha>(srcRow[x - 1]);
+	}
+}
+
+void fastBlitAVX2_RGB565_XRGB8888(byte *dst, const byte *src,
+                                  const uint dstPitch, const uint srcPitch,
+                                  const uint w, const uint h) {
+	fastBlitAVX2_RGB565_8888<false>(dst, src, dstPitch, srcPitch, w, h);
+}
+
+void fastBlitAVX2_RGB565_ARGB8888(byte *dst, const byte *src,
+                                  const uint dstPitch, const uint srcPitch,
+                                  const uint w, const uint h) {
+	fastBlitAVX2_RGB565_8888<true>(dst, src, dstPitch, srcPitch, w, h);
+}
+
+static FORCEINLINE __m256i avx2_convertXRGB8888ToRGB565(__m256i pixels) {
+	__m256i res = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), _mm256_set1_epi32(0xF800));
+	res = _mm256_or_si256(res, _mm256_and_si256(_mm256_srli_epi32(pixels, 5), _mm256_set1_epi32(0x07E0)));
+	return _mm256_or_si256(res, _mm256_and_si256(_mm256_srli_epi32(pixels, 3), _mm256_set1_epi32(0x001F)));
+}
+
+void fastBlitAVX2_XRGB8888_RGB565(byte *dst, const byte *src,
+                                  const uint dstPitch, const uint srcPitch,
+                                  const uint w, const uint h) {
+	for (uint y = 0; y < h; y++) {
+		const uint32 *srcRow = (const uint32 *)(src + y * srcPitch);
+		uint16 *dstRow = (uint16 *)(dst + y * dstPitch);
+
+		uint x = 0;
+		for (; x + 16 <= w; x += 16) {
+			const __m256i lo = avx2_convertXRGB8888ToRGB565(_mm256_loadu_si256((const __m256i *)(srcRow + x)));
+			const __m256i hi = avx2_convertXRGB8888ToRGB565(_mm256_loadu_si256((const __m256i *)(srcRow + x + 8)));
+			// The packing works on each 128-bit lane, so put the pixels back in order
+			const __m256i res = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+			_mm256_storeu_si256((__m256i *)(dstRow + x), res);
+		}
+		for (; x < w; x++)
+			dstRow[x] = convertXRGB8888ToRGB565(srcRow[x]);
+	}
+}
+
+template<bool bswap, int rotate>
+void fastBlitAVX2_swap(byte *dst, const byte *src,
+                       const uint dstPitch, const uint srcPitch,
+                       const uint w, const uint h) {
+	// Both the byte swap and the rotation move whole bytes, so they are a single shuffle
+	byte indices[16];
+	for (int i = 0; i < 16; i++) {
+		const int index = ((i & 3) + rotate / 8) & 3;
+		indices[i] = (i & ~3) + (bswap ? 3 - index : index);
+	}
+	const __m128i shuffle128 = _mm_loadu_si128((const __m128i *)indices);
+	const __m256i shuffle = _mm256_inserti128_si256(_mm256_castsi128_si256(shuffle128), shuffle128, 1);
+
+	for (uint y = 0; y < h; y++) {
+		const uint32 *srcRow = (const uint32 *)(src + y * srcPitch);
+		uint32 *dstRow = (uint32 *)(dst + y * dstPitch);
+
+		uint x = 0;
+		for (; x + 8 <= w; x += 8) {
+			const __m256i pixels = _mm256_loadu_si256((const __m256i *)(srcRow + x));
+			_mm256_storeu_si256((__m256i *)(dstRow + x), _mm256_shuffle_epi8(pixels, shuffle));
+		}
+		for (; x < w; x++) {
+			uint32 col = srcRow[x];
+			if (bswap)
+				col = SWAP_BYTES_32(col);
+			if (rotate != 0)
+				col = ROTATE_RIGHT_32(col, rotate);
+			dstRow[x] = col;
+		}
+	}
+}
+
+template void fastBlitAVX2_swap<true,   0>(byte *, const byte *, const uint, const uint, const uint, const uint);
+template void fastBlitAVX2_swap<false,  8>(byte *, const byte *, const uint, const uint, const uint, const uint);
+template void fastBlitAVX2_swap<false, 24>(byte *, const byte *, const uint, const uint, const uint, const uint);
+template void fastBlitAVX2_swap<true,   8>(byte *, const byte *, const uint, const uint, const uint, const uint);
+template void fastBlitAVX2_swap<true,  24>(byte *, const byte *, const uint, const uint, const uint, const uint);
+
 } // End of namespace Graphics
 
 #if defined(__clang__)
@@ -96,43 +96,87 @@ static const FastBlitLookup fastBlitFuncs_NEON[] = {
 };
 #endif
 
-FastBlitFunc getFastBlitFunc(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
-	const uint dstBpp = dstFmt.bytesPerPixel;
-	const uint srcBpp = srcFmt.bytesPerPixel;
-	const FastBlitLookup *table = nullptr;
-	size_t length = 0;
-
-	if (srcBpp == 4 && dstBpp == 4) {
-		table = fastBlitFuncs_4to4;
-		length = ARRAYSIZE(fastBlitFuncs_4to4);
-
-		for (size_t i = 0; i < length; i++) {
-			if (srcFmt != table[i].srcFmt)
-				continue;
-			if (dstFmt != table[i].dstFmt)
-				continue;
-
-			return table[i].func;
-		}
-	}
+#ifdef SCUMMVM_SSE2
+static const FastBlitLookup fastBlitFuncs_SSE2[] = {
+	// 32-bit byteswap and rotate with SSE2
+	{ fastBlitSSE2_swap<true,   0>, Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0) }, // ABGR8888 -> RGBA8888
+	{ fastBlitSSE2_swap<true,   0>, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0), Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24) }, // RGBA8888 -> ABGR8888
+	{ fastBlitSSE2_swap<true,   0>, Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0) }, // ARGB8888 -> BGRA8888
+	{ fastBlitSSE2_swap<true,   0>, Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0), Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) }, // BGRA8888 -> ARGB8888
+	{ fastBlitSSE2_swap<false,  8>, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0), Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) }, // RGBA8888 -> ARGB8888
+	{ fastBlitSSE2_swap<false,  8>, Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0), Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24) }, // BGRA8888 -> ABGR8888
+	{ fastBlitSSE2_swap<false, 24>, Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24), Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0) }, // ABGR8888 -> BGRA8888
+	{ fastBlitSSE2_swap<false, 24>, Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0) }, // ARGB8888 -> RGBA8888
+	{ fastBlitSSE2_swap<true,   8>, Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24), Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) }, // ABGR8888 -> ARGB8888
+	{ fastBlitSSE2_swap<true,   8>, Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24) }, // ARGB8888 -> ABGR8888
+	{ fastBlitSSE2_swap<true,  24>, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0), Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0) }, // RGBA8888 -> BGRA8888
+	{ fastBlitSSE2_swap<true,  24>, Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0) }, // BGRA8888 -> RGBA8888
+
+	// 16-bit <-> 32-bit
+	{ fastBlitSSE2_RGB565_XRGB8888, Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0), Graphics::PixelFormat(4, 8, 8, 8, 0, 16,  8,  0,  0) }, // RGB565 -> XRGB8888
+	{ fastBlitSSE2_RGB565_ARGB8888, Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0), Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) }, // RGB565 -> ARGB8888
+	{ fastBlitSSE2_XRGB8888_RGB565, Graphics::PixelFormat(4, 8, 8, 8, 0, 16,  8,  0,  0), Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0) }, // XRGB8888 -> RGB565
+	{ fastBlitSSE2_XRGB8888_RGB565, Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0) }  // ARGB8888 -> RGB565
+};
+#endif
 
-#ifdef SCUMMVM_NEON
-	if (srcBpp == 2 && dstBpp == 2 && g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
-		table = fastBlitFuncs_NEON;
-		length = ARRAYSIZE(fastBlitFuncs_NEON);
+#ifdef SCUMMVM_AVX2
+static const FastBlitLookup fastBlitFuncs_AVX2[] = {
+	// 32-bit byteswap and rotate with AVX2
+	{ fastBlitAVX2_swap<true,   0>, Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0) }, // ABGR8888 -> RGBA8888
+	{ fastBlitAVX2_swap<true,   0>, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0), Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24) }, // RGBA8888 -> ABGR8888
+	{ fastBlitAVX2_swap<true,   0>, Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0) }, // ARGB8888 -> BGRA8888
+	{ fastBlitAVX2_swap<true,   0>, Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0), Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) }, // BGRA8888 -> ARGB8888
+	{ fastBlitAVX2_swap<false,  8>, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0), Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) }, // RGBA8888 -> ARGB8888
+	{ fastBlitAVX2_swap<false,  8>, Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0), Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24) }, // BGRA8888 -> ABGR8888
+	{ fastBlitAVX2_swap<false, 24>, Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24), Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0) }, // ABGR8888 -> BGRA8888
+	{ fastBlitAVX2_swap<false, 24>, Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0) }, // ARGB8888 -> RGBA8888
+	{ fastBlitAVX2_swap<true,   8>, Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24), Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) }, // ABGR8888 -> ARGB8888
+	{ fastBlitAVX2_swap<true,   8>, Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24) }, // ARGB8888 -> ABGR8888
+	{ fastBlitAVX2_swap<true,  24>, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0), Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0) }, // RGBA8888 -> BGRA8888
+	{ fastBlitAVX2_swap<true,  24>, Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0) }, // BGRA8888 -> RGBA8888
+
+	// 16-bit <-> 32-bit
+	{ fastBlitAVX2_RGB565_XRGB8888, Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0), Graphics::PixelFormat(4, 8, 8, 8, 0, 16,  8,  0,  0) }, // RGB565 -> XRGB8888
+	{ fastBlitAVX2_RGB565_ARGB8888, Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0), Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24) }, // RGB565 -> ARGB8888
+	{ fastBlitAVX2_XRGB8888_RGB565, Graphics::PixelFormat(4, 8, 8, 8, 0, 16,  8,  0,  0), Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0) }, // XRGB8888 -> RGB565
+	{ fastBlitAVX2_XRGB8888_RGB565, Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0) }  // ARGB8888 -> RGB565
+};
+#endif
 
-		for (size_t i = 0; i < length; i++) {
-			if (srcFmt != table[i].srcFmt)
-				continue;
-			if (dstFmt != table[i].dstFmt)
-				continue;
+static FastBlitFunc findFastBlitFunc(const FastBlitLookup *table, size_t length, const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	for (size_t i = 0; i < length; i++) {
+		if (srcFmt != table[i].srcFmt)
+			continue;
+		if (dstFmt != table[i].dstFmt)
+			continue;
 
-			return table[i].func;
-		}
+		return table[i].func;
 	}
-#endif
 
 	return nullptr;
 }
 
+FastBlitFunc getFastBlitFunc(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	FastBlitFunc func = nullptr;
+
+#ifdef SCUMMVM_AVX2
+	if (!func && g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		func = findFastBlitFunc(fastBlitFuncs_AVX2, ARRAYSIZE(fastBlitFuncs_AVX2), dstFmt, srcFmt);
+#endif
+#ifdef SCUMMVM_SSE2
+	if (!func && g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		func = findFastBlitFunc(fastBlitFuncs_SSE2, ARRAYSIZE(fastBlitFuncs_SSE2), dstFmt, srcFmt);
+#endif
+#ifdef SCUMMVM_NEON
+	if (!func && g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		func = findFastBlitFunc(fastBlitFuncs_NEON, ARRAYSIZE(fastBlitFuncs_NEON), dstFmt, srcFmt);
+#endif
+
+	if (!func && srcFmt.bytesPerPixel == 4 && dstFmt.bytesPerPixel == 4)
+		func = findFastBlitFunc(fastBlitFuncs_4to4, ARRAYSIZE(fastBlitFuncs_4to4), dstFmt, srcFmt);
+
+	return func;
+}
+
 } // End of namespace Graphics
@@ -20,6 +20,7 @@
  */
 
 #include "common/scummsys.h"
+#include "common/endian.h"
 
 #include "graphics/blit/blit-alpha.h"
 #include "graphics/pixelformat.h"
@@ -320,12 +321,154 @@ static inline void blitInnerLoop(BlendBlit::Args &args) {
 	}
 }
 
+template<template <bool RGBMOD, bool ALPHAMOD> class PixelFunc, bool rgbmod, bool alphamod>
+static inline void fillInnerLoop(BlendBlit::Args &args) {
+	const PixelFunc<rgbmod, alphamod> pixelFunc(args.color);
+
+	FillCoeffs coeffs;
+	pixelFunc.fillCoeffs(coeffs);
+
+	const __m128i mul = _mm_set_epi16(coeffs.mul[3], coeffs.mul[2], coeffs.mul[1], coeffs.mul[0], coeffs.mul[3], coeffs.mul[2], coeffs.mul[1], coeffs.mul[0]);
+	const __m128i add = _mm_set_epi16(coeffs.add[3], coeffs.add[2], coeffs.add[1], coeffs.add[0], coeffs.add[3], coeffs.add[2], coeffs.add[1], coeffs.add[0]);
+	const __m128i bias = _mm_set_epi16(coeffs.bias[3], coeffs.bias[2], coeffs.bias[1], coeffs.bias[0], coeffs.bias[3], coeffs.bias[2], coeffs.bias[1], coeffs.bias[0]);
+	const __m128i byteMask = _mm_set1_epi16(0xFF);
+
+	for (uint32 i = 0; i < args.height; i++) {
+		byte *out = args.outo;
+
+		uint32 j = 0;
+		for (; j + 4 <= args.width; j += 4) {
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)out);
+			__m128i lo = _mm_unpacklo_epi8(pixels, _mm_setzero_si128());
+			__m128i hi = _mm_unpackhi_epi8(pixels, _mm_setzero_si128());
+			lo = _mm_and_si128(_mm_add_epi16(_mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, mul), add), 8), bias), byteMask);
+			hi = _mm_and_si128(_mm_add_epi16(_mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, mul), add), 8), bias), byteMask);
+			_mm_storeu_si128((__m128i *)out, _mm_packus_epi16(lo, hi));
+			out += 4 * 4;
+		}
+		for (; j < args.width; j++) {
+			pixelFunc.fill(out);
+			out += 4;
+		}
+		args.outo += args.dstPitch;
+	}
+}
+
 }; // End of class BlendBlitImpl_SSE2
 
 void BlendBlit::blitSSE2(Args &args, const TSpriteBlendMode &blendMode, const AlphaType &alphaType) {
 	blitT<BlendBlitImpl_SSE2>(args, blendMode, alphaType);
 }
 
+void BlendBlit::fillSSE2(Args &args, const TSpriteBlendMode &blendMode) {
+	fillT<BlendBlitImpl_SSE2>(args, blendMode);
+}
+
+template<bool hasAlpha>
+static void fastBlitSSE2_RGB565_8888(byte *dst, const byte *src,
+                                     const uint dstPitch, const uint srcPitch,
+                                     const uint w, const uint h) {
+	const __m128i alpha = _mm_set1_epi16(hasAlpha ? (short)0xFF00 : 0);
+
+	// Converting from bottom right to top left allows converting in place
+	for (uint y = h; y-- > 0;) {
+		const uint16 *srcRow = (const uint16 *)(src + y * srcPitch);
+		uint32 *dstRow = (uint32 *)(dst + y * dstPitch);
+
+		uint x = w;
+		for (; x >= 8; x -= 8) {
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)(srcRow + x - 8));
+			__m128i r = _mm_srli_epi16(pixels, 11);
+			__m128i g = _mm_and_si128(_mm_srli_epi16(pixels, 5), _mm_set1_epi16(0x3F));
+			__m128i b = _mm_and_si128(pixels, _mm_set1_epi16(0x1F));
+			r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+			g = _mm_or_si128(_mm_slli_epi16(g, 2), _mm_srli_epi16(g, 4));
+			b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+
+			const __m128i gb = _mm_or_si128(_mm_slli_epi16(g, 8), b);
+			const __m128i ar = _mm_or_si128(alpha, r);
+			_mm_storeu_si128((__m128i *)(dstRow + x - 8), _mm_unpacklo_epi16(gb, ar));
+			_mm_storeu_si128((__m128i *)(dstRow + x - 4), _mm_unpackhi_epi16(gb, ar));
+		}
+		for (; x > 0; x--)
+			dstRow[x - 1] = convertRGB565ToXRGB8888<hasAlpha>(srcRow[x - 1]);
+	}
+}
+
+void fastBlitSSE2_RGB565_XRGB8888(byte *dst, const byte *src,
+                                  const uint dstPitch, const uint srcPitch,
+                                  const uint w, const uint h) {
+	fastBlitSSE2_RGB565_8888<false>(dst, src, dstPitch, srcPitch, w, h);
+}
+
+void fastBlitSSE2_RGB565_ARGB8888(byte *dst, const byte *src,
+                                  const uint dstPitch, const uint srcPitch,
+                                  const uint w, const uint h) {
+	fastBlitSSE2_RGB565_8888<true>(dst, src, dstPitch, srcPitch, w, h);
+}
+
+static FORCEINLINE __m128i sse2_convertXRGB8888ToRGB565(__m128i pixels) {
+	__m128i res = _mm_and_si128(_mm_srli_epi32(pixels, 8), _mm_set1_epi32(0xF800));
+	res = _mm_or_si128(res, _mm_and_si128(_mm_srli_epi32(pixels, 5), _mm_set1_epi32(0x07E0)));
+	res = _mm_or_si128(res, _mm_and_si128(_mm_srli_epi32(pixels, 3), _mm_set1_epi32(0x001F)));
+	// Sign extend, so that the signed saturation of the packing keeps all bits
+	return _mm_srai_epi32(_mm_slli_epi32(res, 16), 16);
+}
+
+void fastBlitSSE2_XRGB8888_RGB565(byte *dst, const byte *src,
+                                  const uint dstPitch, const uint srcPitch,
+                                  const uint w, const uint h) {
+	for (uint y = 0; y < h; y++) {
+		const uint32 *srcRow = (const uint32 *)(src + y * srcPitch);
+		uint16 *dstRow = (uint16 *)(dst + y * dstPitch);
+
+		uint x = 0;
+		for (; x + 8 <= w; x += 8) {
+			const __m128i lo = sse2_convertXRGB8888ToRGB565(_mm_loadu_si128((const __m128i *)(srcRow + x)));
+			const __m128i hi = sse2_convertXRGB8888ToRGB565(_mm_loadu_si128((const __m128i *)(srcRow + x + 4)));
+			_mm_storeu_si128((__m128i *)(dstRow + x), _mm_packs_epi32(lo, hi));
+		}
+		for (; x < w; x++)
+			dstRow[x] = convertXRGB8888ToRGB565(srcRow[x]);
+	}
+}
+
+template<bool bswap, int rotate>
+void fastBlitSSE2_swap(byte *dst, const byte *src,
+                       const uint dstPitch, const uint srcPitch,
+                       const uint w, const uint h) {
+	for (uint y = 0; y < h; y++) {
+		const uint32 *srcRow = (const uint32 *)(src + y * srcPitch);
+		uint32 *dstRow = (uint32 *)(dst + y * dstPitch);
+
+		uint x = 0;
+		for (; x + 4 <= w; x += 4) {
+			__m128i pixels = _mm_loadu_si128((const __m128i *)(srcRow + x));
+			if (bswap) {
+				pixels = _mm_or_si128(_mm_slli_epi16(pixels, 8), _mm_srli_epi16(pixels, 8));
+				pixels = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+			}
+			if (rotate != 0)
+				pixels = _mm_or_si128(_mm_srli_epi32(pixels, rotate), _mm_slli_epi32(pixels, 32 - rotate));
+			_mm_storeu_si128((__m128i *)(dstRow + x), pixels);
+		}
+		for (; x < w; x++) {
+			uint32 col = srcRow[x];
+			if (bswap)
+				col = SWAP_BYTES_32(col);
+			if (rotate != 0)
+				col = ROTATE_RIGHT_32(col, rotate);
+			dstRow[x] = col;
+		}
+	}
+}
+
+template void fastBlitSSE2_swap<true,   0>(byte *, const byte *, const uint, const uint, const uint, const uint);
+template void fastBlitSSE2_swap<false,  8>(byte *, const byte *, const uint, const uint, const uint, const uint);
+template void fastBlitSSE2_swap<false, 24>(byte *, const byte *, const uint, const uint, const uint, const uint);
+template void fastBlitSSE2_swap<true,   8>(byte *, const byte *, const uint, const uint, const uint, const uint);
+template void fastBlitSSE2_swap<true,  24>(byte *, const byte *, const uint, const uint, const uint, const uint);
+
 } // End of namespace Graphics
 
 #if !defined(__x86_64__)
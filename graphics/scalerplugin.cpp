@@ -57,7 +57,7 @@ void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	}
 }
 
-SourceScaler::SourceScaler(const Graphics::PixelFormat &format) : Scaler(format), _width(0), _height(0), _oldSrc(NULL), _enable(false) {
+SourceScaler::SourceScaler(const Graphics::PixelFormat &format) : Scaler(format), _width(0), _height(0), _bandHeight(0), _oldSrc(NULL), _enable(false) {
 }
 
 SourceScaler::~SourceScaler() {
@@ -105,19 +105,29 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 		return;
 	}
 	int offset = (_padding + x) * _format.bytesPerPixel + (_padding + y) * srcPitch;
-	// Call user defined scale function
-	internScale(srcPtr, srcPitch,
-	            dstPtr, dstPitch,
-	            _oldSrc + offset, srcPitch,
-	            width, height,
-	            (uint8 *)_bufferedOutput.getBasePtr(x * _factor, y * _factor), _bufferedOutput.pitch);
-
-	// Update the destination buffer
-	byte *buffer = (byte *)_bufferedOutput.getBasePtr(x * _factor, y * _factor);
-	for (uint i = 0; i < height * _factor; ++i) {
-		memcpy(buffer, dstPtr, width * _factor * _format.bytesPerPixel);
-		buffer += _bufferedOutput.pitch;
-		dstPtr += dstPitch;
+	const uint rowBytes = width * _factor * _format.bytesPerPixel;
+	const int bandHeight = getBandHeight(width);
+
+	for (int band = 0; band < height; band += bandHeight) {
+		const int bandRows = MIN(bandHeight, height - band);
+		uint8 *dst = dstPtr + band * _factor * dstPitch;
+		byte *buffer = (byte *)_bufferedOutput.getBasePtr(x * _factor, (y + band) * _factor);
+
+		// Call user defined scale function. The old source is only updated
+		// once the whole rect is done, since the scaler compares the pixels
+		// around each band with it.
+		internScale(srcPtr + band * srcPitch, srcPitch,
+		            dst, dstPitch,
+		            _oldSrc + offset + band * srcPitch, srcPitch,
+		            width, bandRows,
+		            buffer, _bufferedOutput.pitch);
+
+		// Update the destination buffer
+		for (uint i = 0; i < bandRows * _factor; ++i) {
+			memcpy(buffer, dst, rowBytes);
+			buffer += _bufferedOutput.pitch;
+			dst += dstPitch;
+		}
 	}
 
 	// Update old src
@@ -129,3 +139,13 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 	}
 }
 
+int SourceScaler::getBandHeight(int width) const {
+	if (_bandHeight > 0)
+		return _bandHeight;
+
+	// Keep a band of output below 128 KB so that it can be copied back
+	// from the cache
+	const uint bandBytes = 128 * 1024;
+	const uint rowBytes = width * _factor * _factor * _format.bytesPerPixel;
+	return MAX<int>(bandBytes / MAX<uint>(rowBytes, 1), 1);
+}
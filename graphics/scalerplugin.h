@@ -122,6 +122,13 @@ public:
 
 	virtual uint setFactor(uint factor) final;
 
+	/**
+	 * Set the number of source rows scaled at a time. Each band is copied
+	 * into the old output buffer right after it was scaled, while it is
+	 * still in the CPU cache. 0 picks a band height from the output size.
+	 */
+	void setBandHeight(int height) { _bandHeight = height; }
+
 protected:
 
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
@@ -141,7 +148,10 @@ protected:
 
 private:
 
+	int getBandHeight(int width) const;
+
 	int _width, _height, _padding;
+	int _bandHeight;
 	bool _enable;
 	byte *_oldSrc;
 	Graphics::Surface _bufferedOutput;
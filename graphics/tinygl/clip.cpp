@@ -248,6 +248,11 @@ void GLContext::gl_draw_triangle(GLVertex *p0, GLVertex *p1, GLVertex *p2) {
 
 	// we handle the non clipped case here to go faster
 	if (co == 0) {
+		// When replaying draw calls for a dirty rectangle, most triangles
+		// do not intersect it
+		if (fb->isTriangleClipped(p0->zp, p1->zp, p2->zp))
+			return;
+
 		norm = (float)(p1->zp.x - p0->zp.x) * (float)(p2->zp.y - p0->zp.y) -
 			   (float)(p2->zp.x - p0->zp.x) * (float)(p1->zp.y - p0->zp.y);
 		if (norm == 0)
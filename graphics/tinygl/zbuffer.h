@@ -370,6 +370,14 @@ private:
 	                     int &dzdx, int &dsdx, int &dtdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
 	                     uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx);
 
+	template <bool kDepthWrite, bool kLightsMode, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending>
+	void putSpanTexture(int fbOffset, const TexelBuffer *texture,
+	                    uint wrap_s, uint wrap_t, uint *pz, int count,
+	                    int x, int y, uint &z, int &t, int &s,
+	                    uint &r, uint &g, uint &b, uint &a,
+	                    int &dzdx, int &dsdx, int &dtdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
+	                    uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx);
+
 	template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool StippleEnabled, bool kDepthTestEnabled>
 	void putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx);
 
@@ -391,6 +399,17 @@ private:
 		return !_clipRectangle.contains(x, y);
 	}
 
+	// Returns a mask with bit i set when pixel x + i of a row inside the
+	// clip rectangle passes the scissor test.
+	FORCEINLINE uint32 scissorSpan(int x, int count) {
+		int start = MAX(_clipRectangle.left - x, 0);
+		int end = MIN(_clipRectangle.right - x, count);
+		if (start >= end)
+			return 0;
+		uint32 mask = (end == 32) ? 0xFFFFFFFF : (1u << end) - 1;
+		return mask & ~((1u << start) - 1);
+	}
+
 public:
 
 	FORCEINLINE void writePixel(int pixel, byte aSrc, byte rSrc, byte gSrc, byte bSrc) {
@@ -573,6 +592,23 @@ public:
 		return _clipRectangle;
 	}
 
+	/**
+	 * Check whether a triangle lies entirely outside of the clipping rectangle,
+	 * in which case rasterizing it would not touch any pixel.
+	 */
+	bool isTriangleClipped(const ZBufferPoint &p0, const ZBufferPoint &p1, const ZBufferPoint &p2) const {
+		if (!_clippingEnabled)
+			return false;
+
+		// Keep a pixel of margin for the rounding of the edge walkers
+		int minX = MIN(p0.x, MIN(p1.x, p2.x)) - 1;
+		int maxX = MAX(p0.x, MAX(p1.x, p2.x)) + 1;
+		int minY = MIN(p0.y, MIN(p1.y, p2.y)) - 1;
+		int maxY = MAX(p0.y, MAX(p1.y, p2.y)) + 1;
+		return maxX < _clipRectangle.left || minX >= _clipRectangle.right ||
+		       maxY < _clipRectangle.top || minY >= _clipRectangle.bottom;
+	}
+
 	void setupScissor(bool enable, const int (&scissor)[4], const Common::Rect *clippingRectangle) {
 		_clippingEnabled = enable || clippingRectangle;
 
@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/tinygl/zspan.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace TinyGL {
+
+template<int kDepthFunc>
+static FORCEINLINE __m256i compareAVX2(__m256i zSrc, __m256i zDst) {
+	// AVX2 only has signed comparisons, flipping the sign bits maps them
+	// onto the unsigned ones.
+	const __m256i bias = _mm256_set1_epi32((int)0x80000000);
+	const __m256i ones = _mm256_set1_epi32(-1);
+	zSrc = _mm256_xor_si256(zSrc, bias);
+	zDst = _mm256_xor_si256(zDst, bias);
+
+	switch (kDepthFunc) {
+	case TGL_LESS:
+		return _mm256_cmpgt_epi32(zSrc, zDst);
+	case TGL_EQUAL:
+		return _mm256_cmpeq_epi32(zSrc, zDst);
+	case TGL_LEQUAL:
+		return _mm256_xor_si256(_mm256_cmpgt_epi32(zDst, zSrc), ones);
+	case TGL_GREATER:
+		return _mm256_cmpgt_epi32(zDst, zSrc);
+	case TGL_NOTEQUAL:
+		return _mm256_xor_si256(_mm256_cmpeq_epi32(zSrc, zDst), ones);
+	default: // TGL_GEQUAL
+		return _mm256_xor_si256(_mm256_cmpgt_epi32(zSrc, zDst), ones);
+	}
+}
+
+static FORCEINLINE __m256i rampAVX2(uint z, uint d) {
+	return _mm256_add_epi32(_mm256_set1_epi32((int)z),
+	                        _mm256_mullo_epi32(_mm256_set1_epi32((int)d), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0)));
+}
+
+template<int kDepthFunc>
+static uint32 testBlocksAVX2(const uint *pz, uint z, int dzdx, uint blocks) {
+	const uint d = dzdx;
+	const __m256i step = _mm256_set1_epi32((int)(d * 8));
+	__m256i zSrc = rampAVX2(z, d);
+
+	uint32 mask = 0;
+	for (uint i = 0; i < blocks; i++) {
+		__m256i pass = compareAVX2<kDepthFunc>(zSrc, _mm256_loadu_si256((const __m256i *)(pz + i * 8)));
+		mask |= (uint32)_mm256_movemask_ps(_mm256_castsi256_ps(pass)) << (i * 8);
+		zSrc = _mm256_add_epi32(zSrc, step);
+	}
+	return mask;
+}
+
+template<int kDepthFunc>
+static void writeBlocksAVX2(uint *pz, uint z, int dzdx, uint blocks) {
+	const uint d = dzdx;
+	const __m256i step = _mm256_set1_epi32((int)(d * 8));
+	__m256i zSrc = rampAVX2(z, d);
+
+	for (uint i = 0; i < blocks; i++) {
+		__m256i zDst = _mm256_loadu_si256((const __m256i *)pz);
+		__m256i pass = compareAVX2<kDepthFunc>(zSrc, zDst);
+		_mm256_storeu_si256((__m256i *)pz, _mm256_blendv_epi8(zDst, zSrc, pass));
+		zSrc = _mm256_add_epi32(zSrc, step);
+		pz += 8;
+	}
+}
+
+uint32 DepthSpan::testAVX2(const uint *pz, uint z, int dzdx, uint count, int depthFunc) {
+	const uint blocks = count / 8;
+	uint32 mask;
+
+	switch (depthFunc) {
+	case TGL_LESS:
+		mask = testBlocksAVX2<TGL_LESS>(pz, z, dzdx, blocks);
+		break;
+	case TGL_EQUAL:
+		mask = testBlocksAVX2<TGL_EQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_LEQUAL:
+		mask = testBlocksAVX2<TGL_LEQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_GREATER:
+		mask = testBlocksAVX2<TGL_GREATER>(pz, z, dzdx, blocks);
+		break;
+	case TGL_NOTEQUAL:
+		mask = testBlocksAVX2<TGL_NOTEQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_GEQUAL:
+		mask = testBlocksAVX2<TGL_GEQUAL>(pz, z, dzdx, blocks);
+		break;
+	default:
+		return testGeneric(pz, z, dzdx, count, depthFunc);
+	}
+
+	const uint done = blocks * 8;
+	if (done < count)
+		mask |= testGeneric(pz + done, z + done * dzdx, dzdx, count - done, depthFunc) << done;
+	return mask;
+}
+
+void DepthSpan::writeAVX2(uint *pz, uint z, int dzdx, uint count, int depthFunc) {
+	const uint blocks = count / 8;
+
+	switch (depthFunc) {
+	case TGL_LESS:
+		writeBlocksAVX2<TGL_LESS>(pz, z, dzdx, blocks);
+		break;
+	case TGL_EQUAL:
+		writeBlocksAVX2<TGL_EQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_LEQUAL:
+		writeBlocksAVX2<TGL_LEQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_GREATER:
+		writeBlocksAVX2<TGL_GREATER>(pz, z, dzdx, blocks);
+		break;
+	case TGL_NOTEQUAL:
+		writeBlocksAVX2<TGL_NOTEQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_GEQUAL:
+		writeBlocksAVX2<TGL_GEQUAL>(pz, z, dzdx, blocks);
+		break;
+	default:
+		writeGeneric(pz, z, dzdx, count, depthFunc);
+		return;
+	}
+
+	const uint done = blocks * 8;
+	writeGeneric(pz + done, z + done * dzdx, dzdx, count - done, depthFunc);
+}
+
+} // end of namespace TinyGL
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,170 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/tinygl/zspan.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace TinyGL {
+
+template<int kDepthFunc>
+static FORCEINLINE __m128i compareSSE2(__m128i zSrc, __m128i zDst) {
+	// SSE2 only has signed comparisons, flipping the sign bits maps them
+	// onto the unsigned ones.
+	const __m128i bias = _mm_set1_epi32((int)0x80000000);
+	const __m128i ones = _mm_set1_epi32(-1);
+	zSrc = _mm_xor_si128(zSrc, bias);
+	zDst = _mm_xor_si128(zDst, bias);
+
+	switch (kDepthFunc) {
+	case TGL_LESS:
+		return _mm_cmpgt_epi32(zSrc, zDst);
+	case TGL_EQUAL:
+		return _mm_cmpeq_epi32(zSrc, zDst);
+	case TGL_LEQUAL:
+		return _mm_xor_si128(_mm_cmpgt_epi32(zDst, zSrc), ones);
+	case TGL_GREATER:
+		return _mm_cmpgt_epi32(zDst, zSrc);
+	case TGL_NOTEQUAL:
+		return _mm_xor_si128(_mm_cmpeq_epi32(zSrc, zDst), ones);
+	default: // TGL_GEQUAL
+		return _mm_xor_si128(_mm_cmpgt_epi32(zSrc, zDst), ones);
+	}
+}
+
+template<int kDepthFunc>
+static uint32 testBlocksSSE2(const uint *pz, uint z, int dzdx, uint blocks) {
+	const uint d = dzdx;
+	const __m128i step = _mm_set1_epi32((int)(d * 4));
+	__m128i zSrc = _mm_set_epi32((int)(z + d * 3), (int)(z + d * 2), (int)(z + d), (int)z);
+
+	uint32 mask = 0;
+	for (uint i = 0; i < blocks; i++) {
+		__m128i pass = compareSSE2<kDepthFunc>(zSrc, _mm_loadu_si128((const __m128i *)(pz + i * 4)));
+		mask |= (uint32)_mm_movemask_ps(_mm_castsi128_ps(pass)) << (i * 4);
+		zSrc = _mm_add_epi32(zSrc, step);
+	}
+	return mask;
+}
+
+template<int kDepthFunc>
+static void writeBlocksSSE2(uint *pz, uint z, int dzdx, uint blocks) {
+	const uint d = dzdx;
+	const __m128i step = _mm_set1_epi32((int)(d * 4));
+	__m128i zSrc = _mm_set_epi32((int)(z + d * 3), (int)(z + d * 2), (int)(z + d), (int)z);
+
+	for (uint i = 0; i < blocks; i++) {
+		__m128i zDst = _mm_loadu_si128((const __m128i *)pz);
+		__m128i pass = compareSSE2<kDepthFunc>(zSrc, zDst);
+		_mm_storeu_si128((__m128i *)pz, _mm_or_si128(_mm_and_si128(pass, zSrc), _mm_andnot_si128(pass, zDst)));
+		zSrc = _mm_add_epi32(zSrc, step);
+		pz += 4;
+	}
+}
+
+uint32 DepthSpan::testSSE2(const uint *pz, uint z, int dzdx, uint count, int depthFunc) {
+	const uint blocks = count / 4;
+	uint32 mask;
+
+	switch (depthFunc) {
+	case TGL_LESS:
+		mask = testBlocksSSE2<TGL_LESS>(pz, z, dzdx, blocks);
+		break;
+	case TGL_EQUAL:
+		mask = testBlocksSSE2<TGL_EQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_LEQUAL:
+		mask = testBlocksSSE2<TGL_LEQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_GREATER:
+		mask = testBlocksSSE2<TGL_GREATER>(pz, z, dzdx, blocks);
+		break;
+	case TGL_NOTEQUAL:
+		mask = testBlocksSSE2<TGL_NOTEQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_GEQUAL:
+		mask = testBlocksSSE2<TGL_GEQUAL>(pz, z, dzdx, blocks);
+		break;
+	default:
+		return testGeneric(pz, z, dzdx, count, depthFunc);
+	}
+
+	const uint done = blocks * 4;
+	if (done < count)
+		mask |= testGeneric(pz + done, z + done * dzdx, dzdx, count - done, depthFunc) << done;
+	return mask;
+}
+
+void DepthSpan::writeSSE2(uint *pz, uint z, int dzdx, uint count, int depthFunc) {
+	const uint blocks = count / 4;
+
+	switch (depthFunc) {
+	case TGL_LESS:
+		writeBlocksSSE2<TGL_LESS>(pz, z, dzdx, blocks);
+		break;
+	case TGL_EQUAL:
+		writeBlocksSSE2<TGL_EQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_LEQUAL:
+		writeBlocksSSE2<TGL_LEQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_GREATER:
+		writeBlocksSSE2<TGL_GREATER>(pz, z, dzdx, blocks);
+		break;
+	case TGL_NOTEQUAL:
+		writeBlocksSSE2<TGL_NOTEQUAL>(pz, z, dzdx, blocks);
+		break;
+	case TGL_GEQUAL:
+		writeBlocksSSE2<TGL_GEQUAL>(pz, z, dzdx, blocks);
+		break;
+	default:
+		writeGeneric(pz, z, dzdx, count, depthFunc);
+		return;
+	}
+
+	const uint done = blocks * 4;
+	writeGeneric(pz + done, z + done * dzdx, dzdx, count - done, depthFunc);
+}
+
+} // end of namespace TinyGL
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
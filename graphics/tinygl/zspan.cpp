@@ -0,0 +1,97 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/system.h"
+
+#include "graphics/tinygl/zspan.h"
+
+namespace TinyGL {
+
+DepthSpan::TestFunc DepthSpan::testFunc = nullptr;
+DepthSpan::WriteFunc DepthSpan::writeFunc = nullptr;
+
+void DepthSpan::init() {
+	testFunc = testGeneric;
+	writeFunc = writeGeneric;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		testFunc = testSSE2;
+		writeFunc = writeSSE2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		testFunc = testAVX2;
+		writeFunc = writeAVX2;
+	}
+#endif
+}
+
+uint32 DepthSpan::test(const uint *pz, uint z, int dzdx, uint count, int depthFunc) {
+	assert(count <= kMaxTestCount);
+
+	// The SIMD variants only implement the actual comparisons
+	if (depthFunc == TGL_NEVER)
+		return 0;
+	if (depthFunc == TGL_ALWAYS)
+		return count == 32 ? 0xFFFFFFFF : (1u << count) - 1;
+
+	if (!testFunc)
+		init();
+	return testFunc(pz, z, dzdx, count, depthFunc);
+}
+
+void DepthSpan::write(uint *pz, uint z, int dzdx, uint count, int depthFunc) {
+	if (depthFunc == TGL_NEVER)
+		return;
+	if (depthFunc == TGL_ALWAYS) {
+		writeGeneric(pz, z, dzdx, count, depthFunc);
+		return;
+	}
+
+	if (!writeFunc)
+		init();
+	writeFunc(pz, z, dzdx, count, depthFunc);
+}
+
+// The SIMD variants rely on the generic versions below for the remaining
+// pixels of a span, so these define the exact results every variant has
+// to produce.
+
+uint32 DepthSpan::testGeneric(const uint *pz, uint z, int dzdx, uint count, int depthFunc) {
+	uint32 mask = 0;
+	for (uint i = 0; i < count; i++) {
+		if (compare(z, pz[i], depthFunc))
+			mask |= 1u << i;
+		z += dzdx;
+	}
+	return mask;
+}
+
+void DepthSpan::writeGeneric(uint *pz, uint z, int dzdx, uint count, int depthFunc) {
+	for (uint i = 0; i < count; i++) {
+		if (compare(z, pz[i], depthFunc))
+			pz[i] = z;
+		z += dzdx;
+	}
+}
+
+} // end of namespace TinyGL
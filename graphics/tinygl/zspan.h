@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_TINYGL_ZSPAN_H
+#define GRAPHICS_TINYGL_ZSPAN_H
+
+#include "common/scummsys.h"
+
+#include "graphics/tinygl/gl.h"
+
+class TinyGLDepthSpanTestSuite;
+
+namespace TinyGL {
+
+/**
+ * Depth test kernels which work on a whole span of pixels at once. Depth
+ * values along a span are z, z + dzdx, z + 2 * dzdx, ... and are compared
+ * with the depth buffer exactly like FrameBuffer::compareDepth() does.
+ *
+ * The kernels are dispatched at runtime to a SIMD variant if the CPU
+ * supports one.
+ */
+class DepthSpan {
+public:
+	enum {
+		kMaxTestCount = 32
+	};
+
+	/**
+	 * Tests up to kMaxTestCount pixels against the depth buffer.
+	 *
+	 * @return A mask with bit i set when pixel i passes the depth test.
+	 */
+	static uint32 test(const uint *pz, uint z, int dzdx, uint count, int depthFunc);
+
+	/**
+	 * Tests a span of any length against the depth buffer and stores the
+	 * depth of all pixels which pass the test.
+	 */
+	static void write(uint *pz, uint z, int dzdx, uint count, int depthFunc);
+
+private:
+	typedef uint32 (*TestFunc)(const uint *, uint, int, uint, int);
+	typedef void (*WriteFunc)(uint *, uint, int, uint, int);
+
+	static TestFunc testFunc;
+	static WriteFunc writeFunc;
+
+	static void init();
+
+	static FORCEINLINE bool compare(uint zSrc, uint zDst, int depthFunc) {
+		switch (depthFunc) {
+		case TGL_LESS:
+			return zDst < zSrc;
+		case TGL_EQUAL:
+			return zDst == zSrc;
+		case TGL_LEQUAL:
+			return zDst <= zSrc;
+		case TGL_GREATER:
+			return zDst > zSrc;
+		case TGL_NOTEQUAL:
+			return zDst != zSrc;
+		case TGL_GEQUAL:
+			return zDst >= zSrc;
+		case TGL_ALWAYS:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static uint32 testGeneric(const uint *pz, uint z, int dzdx, uint count, int depthFunc);
+	static void writeGeneric(uint *pz, uint z, int dzdx, uint count, int depthFunc);
+#ifdef SCUMMVM_SSE2
+	static uint32 testSSE2(const uint *pz, uint z, int dzdx, uint count, int depthFunc);
+	static void writeSSE2(uint *pz, uint z, int dzdx, uint count, int depthFunc);
+#endif
+#ifdef SCUMMVM_AVX2
+	static uint32 testAVX2(const uint *pz, uint z, int dzdx, uint count, int depthFunc);
+	static void writeAVX2(uint *pz, uint z, int dzdx, uint count, int depthFunc);
+#endif
+
+	friend class ::TinyGLDepthSpanTestSuite;
+};
+
+} // end of namespace TinyGL
+
+#endif
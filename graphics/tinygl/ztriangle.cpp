@@ -29,6 +29,7 @@
 #include "graphics/tinygl/texelbuffer.h"
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/zspan.h"
 
 namespace TinyGL {
 
@@ -149,6 +150,39 @@ end:
 	}
 }
 
+template <bool kDepthWrite, bool kLightsMode, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending>
+void FrameBuffer::putSpanTexture(int fbOffset, const TexelBuffer *texture,
+                                 uint wrap_s, uint wrap_t, uint *pz, int count,
+                                 int x, int y, uint &z, int &t, int &s,
+                                 uint &r, uint &g, uint &b, uint &a,
+                                 int &dzdx, int &dsdx, int &dtdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
+                                 uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx) {
+	uint32 mask = DepthSpan::test(pz, z, dzdx, count, _depthFunc);
+	if (kEnableScissor) {
+		mask &= scissorSpan(x, count);
+	}
+
+	for (int _a = 0; _a < count; _a++) {
+		if (mask & (1u << _a)) {
+			putPixelTexture<kDepthWrite, kLightsMode, kSmoothMode, kFogMode, kEnableAlphaTest, false, kEnableBlending, false, false>
+			               (fbOffset, texture, wrap_s, wrap_t, pz, nullptr, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+		} else {
+			z += dzdx;
+			s += dsdx;
+			t += dtdx;
+			if (kFogMode) {
+				fog += dfdx;
+			}
+			if (kSmoothMode) {
+				a += dadx;
+				r += drdx;
+				g += dgdx;
+				b += dbdx;
+			}
+		}
+	}
+}
+
 template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
 void FrameBuffer::putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx) {
 	if (kEnableScissor && scissorPixel(x + _a, y)) {
@@ -215,6 +249,10 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 	byte fog_r = 0, fog_g = 0, fog_b = 0;
 
+	// Without stencil and stipple tests, the depth test of whole spans can
+	// be done up front and only the passing pixels need to be shaded
+	const bool kSpanDepthTest = kInterpZ && kDepthTestEnabled && !kStencilEnabled && !kStippleEnabled;
+
 	// we sort the vertex with increasing y
 	if (p1->y < p0->y) {
 		tp = p0;
@@ -449,7 +487,9 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
 			int x = x1;
-			if (!kInterpRGB) {
+			if (kEnableScissor && (y < _clipRectangle.top || y >= _clipRectangle.bottom)) {
+				// The scissor test rejects the whole line, only the edges need to be stepped
+			} else if (!kInterpRGB) {
 				int n;
 				uint *pz;
 				byte *ps = nullptr;
@@ -462,6 +502,18 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kSpanDepthTest) {
+					// Only the depth writes are left, the scissor test just shortens the span
+					int start = 0, end = n + 1;
+					if (kEnableScissor) {
+						start = MAX(_clipRectangle.left - x, 0);
+						end = MIN(_clipRectangle.right - x, end);
+					}
+					if (kDepthWrite && start < end) {
+						DepthSpan::write(pz + start, z + (uint)start * dzdx, dzdx, end - start, _depthFunc);
+					}
+					n = -1;
+				}
 				while (n >= 3) {
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
@@ -508,6 +560,34 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				while (kSpanDepthTest && n >= 0) {
+					const int count = MIN<int>(n + 1, DepthSpan::kMaxTestCount);
+					uint32 mask = DepthSpan::test(pz, z, dzdx, count, _depthFunc);
+					if (kEnableScissor) {
+						mask &= scissorSpan(x, count);
+					}
+					for (int _a = 0; _a < count; _a++) {
+						if (mask & (1u << _a)) {
+							putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, false, kBlendingEnabled, false, false, false>
+							                 (pp, pz, ps, _a, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						} else {
+							z += dzdx;
+							if (kFogMode) {
+								fog += dfdx;
+							}
+							if (kSmoothMode) {
+								r += drdx;
+								g += dgdx;
+								b += dbdx;
+								a += dadx;
+							}
+						}
+					}
+					pp += count;
+					pz += count;
+					n -= count;
+					x += count;
+				}
 				while (n >= 3) {
 					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
 					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
@@ -582,9 +662,14 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						fz += fndzdx;
 						zinv = (float)(1.0 / fz);
 					}
-					for (int _a = 0; _a < NB_INTERP; _a++) {
-						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					if (kSpanDepthTest) {
+						putSpanTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>
+						              (pp, texture, _wrapS, _wrapT, pz, NB_INTERP, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					} else {
+						for (int _a = 0; _a < NB_INTERP; _a++) {
+							putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+							               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						}
 					}
 					pp += NB_INTERP;
 					if (kInterpZ) {
@@ -609,6 +694,11 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
 				}
 
+				if (kSpanDepthTest && n >= 0) {
+					putSpanTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>
+					              (pp, texture, _wrapS, _wrapT, pz, n + 1, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					n = -1;
+				}
 				while (n >= 0) {
 					putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
 					               (pp, texture, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
@@ -0,0 +1,126 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+class YUVToRGBImpl_AVX2 {
+	friend class YUVToRGBManager;
+
+static FORCEINLINE __m256i loadChroma(const int16 *src, int x, bool halfChroma) {
+	if (halfChroma) {
+		__m128i c = _mm_loadu_si128((const __m128i *)(src + (x >> 1)));
+		return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(c, c)), _mm_unpackhi_epi16(c, c), 1);
+	}
+	return _mm256_loadu_si256((const __m256i *)(src + x));
+}
+
+template<bool kITU>
+static FORCEINLINE __m256i scale(__m256i x) {
+	if (kITU) {
+		// (CLIP(x, 16, 235) - 16) * 255 / 219, with the division done as
+		// a multiplication which is exact for the possible products
+		x = _mm256_min_epi16(_mm256_max_epi16(x, _mm256_set1_epi16(16)), _mm256_set1_epi16(235));
+		x = _mm256_mullo_epi16(_mm256_sub_epi16(x, _mm256_set1_epi16(16)), _mm256_set1_epi16(255));
+		return _mm256_srli_epi16(_mm256_mulhi_epu16(x, _mm256_set1_epi16((short)38305)), 7);
+	}
+	return _mm256_min_epi16(_mm256_max_epi16(x, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+}
+
+static FORCEINLINE __m256i widen(__m256i x, int half, __m128i shift) {
+	// Unlike the unpack instructions this keeps the pixels in order
+	return _mm256_sll_epi32(_mm256_cvtepu16_epi32(half ? _mm256_extracti128_si256(x, 1) : _mm256_castsi256_si128(x)), shift);
+}
+
+template<bool kITU, int kBytesPerPixel>
+static void convertRow(const YUVToRGBManager::RowArgs &args, int &x) {
+	const PixelFormat &format = args.format;
+	const __m128i rLoss = _mm_cvtsi32_si128(format.rLoss), rShift = _mm_cvtsi32_si128(format.rShift);
+	const __m128i gLoss = _mm_cvtsi32_si128(format.gLoss), gShift = _mm_cvtsi32_si128(format.gShift);
+	const __m128i bLoss = _mm_cvtsi32_si128(format.bLoss), bShift = _mm_cvtsi32_si128(format.bShift);
+	const __m128i aLoss = _mm_cvtsi32_si128(format.aLoss), aShift = _mm_cvtsi32_si128(format.aShift);
+
+	for (; x + 16 <= args.width; x += 16) {
+		const __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(args.ySrc + x)));
+		__m256i r = scale<kITU>(_mm256_add_epi16(y, loadChroma(args.crR, x, args.halfChroma)));
+		__m256i g = scale<kITU>(_mm256_add_epi16(y, loadChroma(args.crbG, x, args.halfChroma)));
+		__m256i b = scale<kITU>(_mm256_add_epi16(y, loadChroma(args.cbB, x, args.halfChroma)));
+		__m256i a = args.aSrc ? _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(args.aSrc + x))) : _mm256_set1_epi16(0xFF);
+
+		r = _mm256_srl_epi16(r, rLoss);
+		g = _mm256_srl_epi16(g, gLoss);
+		b = _mm256_srl_epi16(b, bLoss);
+		a = _mm256_srl_epi16(a, aLoss);
+
+		if (kBytesPerPixel == 2) {
+			__m256i pixels = _mm256_or_si256(_mm256_or_si256(_mm256_sll_epi16(r, rShift), _mm256_sll_epi16(g, gShift)),
+			                                 _mm256_or_si256(_mm256_sll_epi16(b, bShift), _mm256_sll_epi16(a, aShift)));
+			_mm256_storeu_si256((__m256i *)((uint16 *)args.dst + x), pixels);
+		} else {
+			__m256i lo = _mm256_or_si256(_mm256_or_si256(widen(r, 0, rShift), widen(g, 0, gShift)),
+			                             _mm256_or_si256(widen(b, 0, bShift), widen(a, 0, aShift)));
+			__m256i hi = _mm256_or_si256(_mm256_or_si256(widen(r, 1, rShift), widen(g, 1, gShift)),
+			                             _mm256_or_si256(widen(b, 1, bShift), widen(a, 1, aShift)));
+			_mm256_storeu_si256((__m256i *)((uint32 *)args.dst + x), lo);
+			_mm256_storeu_si256((__m256i *)((uint32 *)args.dst + x + 8), hi);
+		}
+	}
+}
+
+}; // End of class YUVToRGBImpl_AVX2
+
+void YUVToRGBManager::convertRowAVX2(const RowArgs &args) {
+	int x = 0;
+
+	if (args.format.bytesPerPixel == 2) {
+		if (args.scale == kScaleITU)
+			YUVToRGBImpl_AVX2::convertRow<true, 2>(args, x);
+		else
+			YUVToRGBImpl_AVX2::convertRow<false, 2>(args, x);
+	} else if (args.format.bytesPerPixel == 4) {
+		if (args.scale == kScaleITU)
+			YUVToRGBImpl_AVX2::convertRow<true, 4>(args, x);
+		else
+			YUVToRGBImpl_AVX2::convertRow<false, 4>(args, x);
+	}
+
+	convertRowTail(args, x);
+}
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
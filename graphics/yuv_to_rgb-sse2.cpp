@@ -0,0 +1,130 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+class YUVToRGBImpl_SSE2 {
+	friend class YUVToRGBManager;
+
+static FORCEINLINE __m128i loadChroma(const int16 *src, int x, bool halfChroma) {
+	if (halfChroma) {
+		__m128i c = _mm_loadl_epi64((const __m128i *)(src + (x >> 1)));
+		return _mm_unpacklo_epi16(c, c);
+	}
+	return _mm_loadu_si128((const __m128i *)(src + x));
+}
+
+template<bool kITU>
+static FORCEINLINE __m128i scale(__m128i x) {
+	if (kITU) {
+		// (CLIP(x, 16, 235) - 16) * 255 / 219, with the division done as
+		// a multiplication which is exact for the possible products
+		x = _mm_min_epi16(_mm_max_epi16(x, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		x = _mm_mullo_epi16(_mm_sub_epi16(x, _mm_set1_epi16(16)), _mm_set1_epi16(255));
+		return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16((short)38305)), 7);
+	}
+	return _mm_min_epi16(_mm_max_epi16(x, _mm_setzero_si128()), _mm_set1_epi16(255));
+}
+
+template<bool kITU, int kBytesPerPixel>
+static void convertRow(const YUVToRGBManager::RowArgs &args, int &x) {
+	const PixelFormat &format = args.format;
+	const __m128i rLoss = _mm_cvtsi32_si128(format.rLoss), rShift = _mm_cvtsi32_si128(format.rShift);
+	const __m128i gLoss = _mm_cvtsi32_si128(format.gLoss), gShift = _mm_cvtsi32_si128(format.gShift);
+	const __m128i bLoss = _mm_cvtsi32_si128(format.bLoss), bShift = _mm_cvtsi32_si128(format.bShift);
+	const __m128i aLoss = _mm_cvtsi32_si128(format.aLoss), aShift = _mm_cvtsi32_si128(format.aShift);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; x + 8 <= args.width; x += 8) {
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(args.ySrc + x)), zero);
+		__m128i r = scale<kITU>(_mm_add_epi16(y, loadChroma(args.crR, x, args.halfChroma)));
+		__m128i g = scale<kITU>(_mm_add_epi16(y, loadChroma(args.crbG, x, args.halfChroma)));
+		__m128i b = scale<kITU>(_mm_add_epi16(y, loadChroma(args.cbB, x, args.halfChroma)));
+		__m128i a = args.aSrc ? _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(args.aSrc + x)), zero) : _mm_set1_epi16(0xFF);
+
+		r = _mm_srl_epi16(r, rLoss);
+		g = _mm_srl_epi16(g, gLoss);
+		b = _mm_srl_epi16(b, bLoss);
+		a = _mm_srl_epi16(a, aLoss);
+
+		if (kBytesPerPixel == 2) {
+			__m128i pixels = _mm_or_si128(_mm_or_si128(_mm_sll_epi16(r, rShift), _mm_sll_epi16(g, gShift)),
+			                              _mm_or_si128(_mm_sll_epi16(b, bShift), _mm_sll_epi16(a, aShift)));
+			_mm_storeu_si128((__m128i *)((uint16 *)args.dst + x), pixels);
+		} else {
+			__m128i lo = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), gShift)),
+			                          _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(b, zero), bShift), _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), aShift)));
+			__m128i hi = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), gShift)),
+			                          _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(b, zero), bShift), _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), aShift)));
+			_mm_storeu_si128((__m128i *)((uint32 *)args.dst + x), lo);
+			_mm_storeu_si128((__m128i *)((uint32 *)args.dst + x + 4), hi);
+		}
+	}
+}
+
+}; // End of class YUVToRGBImpl_SSE2
+
+void YUVToRGBManager::convertRowSSE2(const RowArgs &args) {
+	int x = 0;
+
+	if (args.format.bytesPerPixel == 2) {
+		if (args.scale == kScaleITU)
+			YUVToRGBImpl_SSE2::convertRow<true, 2>(args, x);
+		else
+			YUVToRGBImpl_SSE2::convertRow<false, 2>(args, x);
+	} else if (args.format.bytesPerPixel == 4) {
+		if (args.scale == kScaleITU)
+			YUVToRGBImpl_SSE2::convertRow<true, 4>(args, x);
+		else
+			YUVToRGBImpl_SSE2::convertRow<false, 4>(args, x);
+	}
+
+	convertRowTail(args, x);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
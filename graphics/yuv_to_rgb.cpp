@@ -82,6 +82,7 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
@@ -98,12 +99,14 @@ public:
 	Graphics::PixelFormat getFormat() const { return _format; }
 	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
 	const int16 *getColorTable() const { return _colorTab; }
+	const int16 *getChromaTable() const { return _chromaTab; }
 	const byte *getClipTable() const { return _clipTable; }
 
 private:
 	Graphics::PixelFormat _format;
 	YUVToRGBManager::LuminanceScale _scale;
 	int16 _colorTab[4 * 256]; // 2048 bytes
+	int16 _chromaTab[4 * 256]; // The same without the clip table offsets
 	byte _clipTable[3 * 768];
 };
 
@@ -178,11 +181,18 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 		Cr_g_tab[i] = (int16) (-(0.299 / 0.419) * CR) + g_offset + 256;
 		Cb_g_tab[i] = (int16) (-(0.114 / 0.331) * CB);
 		Cb_b_tab[i] = (int16) ( (0.587 / 0.331) * CB) + b_offset + 256;
+
+		_chromaTab[0 * 256 + i] = Cr_r_tab[i] - (r_offset + 256);
+		_chromaTab[1 * 256 + i] = Cr_g_tab[i] - (g_offset + 256);
+		_chromaTab[2 * 256 + i] = Cb_g_tab[i];
+		_chromaTab[3 * 256 + i] = Cb_b_tab[i] - (b_offset + 256);
 	}
 }
 
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
+	_convertRowFunc = 0;
+	_convertRowFuncInit = false;
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
@@ -198,6 +208,124 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+YUVToRGBManager::ConvertRowFunc YUVToRGBManager::getConvertRowFunc() {
+	if (_convertRowFuncInit)
+		return _convertRowFunc;
+
+	_convertRowFuncInit = true;
+	_convertRowFunc = 0;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_convertRowFunc = convertRowSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		_convertRowFunc = convertRowAVX2;
+#endif
+	return _convertRowFunc;
+}
+
+bool YUVToRGBManager::convertRows(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int xShift, int yShift) {
+	ConvertRowFunc convertRow = getConvertRowFunc();
+	if (!convertRow)
+		return false;
+
+	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const int16 *Cr_r_tab = lookup->getChromaTable();
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+
+	const int chromaWidth = yWidth >> xShift;
+	_chromaBuffer.resize(chromaWidth * 3);
+
+	int16 *crR = &_chromaBuffer[0];
+	int16 *crbG = crR + chromaWidth;
+	int16 *cbB = crbG + chromaWidth;
+
+	RowArgs args;
+	args.crR = crR;
+	args.crbG = crbG;
+	args.cbB = cbB;
+	args.width = yWidth;
+	args.halfChroma = (xShift != 0);
+	args.scale = scale;
+	args.format = dst->format;
+
+	for (int h = 0; h < yHeight; h++) {
+		// The chroma part of the conversion is shared by all rows using
+		// the same chroma samples
+		if ((h & ((1 << yShift) - 1)) == 0) {
+			const byte *u = uSrc + (h >> yShift) * uvPitch;
+			const byte *v = vSrc + (h >> yShift) * uvPitch;
+
+			for (int c = 0; c < chromaWidth; c++) {
+				crR[c]  = Cr_r_tab[v[c]];
+				crbG[c] = Cr_g_tab[v[c]] + Cb_g_tab[u[c]];
+				cbB[c]  = Cb_b_tab[u[c]];
+			}
+		}
+
+		args.dst = (byte *)dst->getPixels() + h * dst->pitch;
+		args.ySrc = ySrc + h * yPitch;
+		args.aSrc = aSrc ? aSrc + h * yPitch : 0;
+		convertRow(args);
+	}
+
+	return true;
+}
+
+// The SIMD row converters rely on this for the remaining pixels of a row,
+// so it defines the exact results every variant has to produce. These are
+// the same as the ones of the lookup tables below.
+void YUVToRGBManager::convertRowGeneric(const RowArgs &args) {
+	const PixelFormat &format = args.format;
+	const bool itu = (args.scale == kScaleITU);
+
+	for (int x = 0; x < args.width; x++) {
+		const int c = args.halfChroma ? (x >> 1) : x;
+		int r = args.ySrc[x] + args.crR[c];
+		int g = args.ySrc[x] + args.crbG[c];
+		int b = args.ySrc[x] + args.cbB[c];
+
+		if (itu) {
+			r = (CLIP(r, 16, 235) - 16) * 255 / 219;
+			g = (CLIP(g, 16, 235) - 16) * 255 / 219;
+			b = (CLIP(b, 16, 235) - 16) * 255 / 219;
+		} else {
+			r = CLIP(r, 0, 255);
+			g = CLIP(g, 0, 255);
+			b = CLIP(b, 0, 255);
+		}
+
+		const uint a = args.aSrc ? args.aSrc[x] : 0xFF;
+		const uint32 pixel = ((r >> format.rLoss) << format.rShift) | ((g >> format.gLoss) << format.gShift) |
+		                     ((b >> format.bLoss) << format.bShift) | ((a >> format.aLoss) << format.aShift);
+
+		if (format.bytesPerPixel == 2)
+			*((uint16 *)args.dst + x) = pixel;
+		else
+			*((uint32 *)args.dst + x) = pixel;
+	}
+}
+
+void YUVToRGBManager::convertRowTail(const RowArgs &args, int done) {
+	if (done >= args.width)
+		return;
+
+	RowArgs tail = args;
+	const int chromaDone = args.halfChroma ? (done >> 1) : done;
+	tail.dst += done * args.format.bytesPerPixel;
+	tail.ySrc += done;
+	if (tail.aSrc)
+		tail.aSrc += done;
+	tail.crR += chromaDone;
+	tail.crbG += chromaDone;
+	tail.cbB += chromaDone;
+	tail.width -= done;
+	convertRowGeneric(tail);
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
@@ -244,6 +372,9 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 
+	if (convertRows(dst, scale, ySrc, uSrc, vSrc, 0, yWidth, yHeight, yPitch, uvPitch, 0, 0))
+		return;
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
@@ -301,6 +432,9 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(ySrc && uSrc && vSrc);
 	assert((yWidth & 1) == 0);
 
+	if (convertRows(dst, scale, ySrc, uSrc, vSrc, 0, yWidth, yHeight, yPitch, uvPitch, 1, 0))
+		return;
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
@@ -362,6 +496,9 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
+	if (convertRows(dst, scale, ySrc, uSrc, vSrc, 0, yWidth, yHeight, yPitch, uvPitch, 1, 1))
+		return;
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
@@ -431,6 +568,9 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
+	if (convertRows(dst, scale, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch, 1, 1))
+		return;
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
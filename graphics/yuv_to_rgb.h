@@ -38,9 +38,12 @@
 #define GRAPHICS_YUV_TO_RGB_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
+class YUVToRGBTestSuite;
+
 namespace Graphics {
 
 class YUVToRGBLookup;
@@ -143,6 +146,48 @@ private:
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
 	YUVToRGBLookup *_lookup;
+
+	/** The arguments for converting a single row of pixels */
+	struct RowArgs {
+		byte *dst;
+		const byte *ySrc;
+		const byte *aSrc;  ///< Source of the alpha values, or 0 for opaque pixels
+		const int16 *crR;  ///< Chroma offsets, one for every chroma sample
+		const int16 *crbG;
+		const int16 *cbB;
+		int width;
+		bool halfChroma;   ///< Whether there is one chroma sample for every two pixels
+		LuminanceScale scale;
+		PixelFormat format;
+	};
+
+	typedef void (*ConvertRowFunc)(const RowArgs &args);
+
+	/**
+	 * Convert an image row by row with a SIMD row converter.
+	 *
+	 * @return false if there is no SIMD row converter for this CPU
+	 */
+	bool convertRows(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int xShift, int yShift);
+
+	ConvertRowFunc getConvertRowFunc();
+
+	ConvertRowFunc _convertRowFunc;
+	bool _convertRowFuncInit;
+	Common::Array<int16> _chromaBuffer;
+
+	static void convertRowGeneric(const RowArgs &args);
+	static void convertRowTail(const RowArgs &args, int done);
+#ifdef SCUMMVM_SSE2
+	static void convertRowSSE2(const RowArgs &args);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void convertRowAVX2(const RowArgs &args);
+#endif
+
+	friend class ::YUVToRGBTestSuite;
+	friend class YUVToRGBImpl_SSE2;
+	friend class YUVToRGBImpl_AVX2;
 };
  /** @} */
 } // End of namespace Graphics
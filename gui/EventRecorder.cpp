@@ -19,6 +19,9 @@
  *
  */
 
+#if defined(POSIX)
+#include <sys/resource.h>
+#endif
 
 #include "gui/EventRecorder.h"
 
@@ -31,8 +34,11 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "common/debug-channels.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/mixer/mixer.h"
+#include "common/algorithm.h"
 #include "common/config-manager.h"
+#include "common/file.h"
 #include "common/md5.h"
+#include "common/formats/json.h"
 #include "gui/gui-manager.h"
 #include "gui/widget.h"
 #include "gui/onscreendialog.h"
@@ -78,6 +84,11 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 	_recordFile = nullptr;
+	_benchmark = false;
+	_benchmarkStart = 0;
+	_benchmarkFrameStart = 0;
+	_benchmarkFrameEnd = 0;
+	_benchmarkMixerTime = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -88,6 +99,9 @@ void EventRecorder::deinit() {
 	if (!_initialized) {
 		return;
 	}
+	if (_benchmark) {
+		writeBenchmarkReport();
+	}
 	setFileHeader();
 	_needRedraw = false;
 	_initialized = false;
@@ -161,7 +175,7 @@ void EventRecorder::processTimeAndDate(TimeDate &td, bool skipRecord) {
 			_recordFile->writeEvent(timeDateEvent);
 		}
 
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextPlaybackEvent();
 	}
 	if (_recordMode == kRecorderPlaybackPause)
 		td = _lastTimeDate;
@@ -218,7 +232,7 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_recordFile->writeEvent(timerEvent);
 		}
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextPlaybackEvent();
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -260,7 +274,7 @@ void EventRecorder::processScreenUpdate() {
 		if (_nextEvent.recordedtype != Common::kRecorderEventTypeScreenUpdate) {
 			int numSkipped = 0;
 			while (true) {
-				_nextEvent = _playbackFile->getNextEvent();
+				_nextEvent = getNextPlaybackEvent();
 				numSkipped += 1;
 				if (_nextEvent.recordedtype == Common::kRecorderEventTypeScreenUpdate) {
 					warning("Skipped %d events to get to the next screen update at %d", numSkipped, _nextEvent.time);
@@ -271,7 +285,7 @@ void EventRecorder::processScreenUpdate() {
 		_processingMillis = true;
 		_fakeTimer = _nextEvent.time;
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextPlaybackEvent();
 		if (_recordMode == kRecorderUpdate) {
 			// write event to the updated file and update screenshot if necessary
 			screenUpdateEvent.recordedtype = Common::kRecorderEventTypeScreenUpdate;
@@ -308,7 +322,7 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 	}
 
 	ev = _nextEvent;
-	_nextEvent = _playbackFile->getNextEvent();
+	_nextEvent = getNextPlaybackEvent();
 	switch (ev.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -388,7 +402,19 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	_lastMillis = g_system->getMillis();
 	_lastScreenshotTime = 0;
 	_recordMode = mode;
+	_recordFileName = recordFileName;
 	_needcontinueGame = false;
+	_benchmark = (_recordMode == kRecorderPlayback) && ConfMan.hasKey("benchmark");
+	if (_benchmark) {
+		// Run the recording as fast as possible and only keep track of the time spent
+		_fastPlayback = true;
+		_benchmarkStart = getBenchmarkMicros();
+		_benchmarkFrameEnd = _benchmarkStart;
+		_benchmarkMixerTime = 0;
+		_benchmarkTickTimes.clear();
+		_benchmarkBlitTimes.clear();
+		_benchmarkMixerTimes.clear();
+	}
 	if (ConfMan.hasKey("disable_display")) {
 		DebugMan.enableDebugChannel("EventRec");
 		gDebugLevel = 1;
@@ -415,7 +441,7 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	}
 	if ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate)) {
 		applyPlaybackSettings();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextPlaybackEvent();
 	}
 	if ((_recordMode == kRecorderRecord) || (_recordMode == kRecorderUpdate)) {
 		getConfig();
@@ -571,7 +597,13 @@ void EventRecorder::updateSubsystems() {
 	}
 	RecordMode oldRecordMode = _recordMode;
 	_recordMode = kPassthrough;
-	_fakeMixerManager->update();
+	if (_benchmark) {
+		uint64 start = getBenchmarkMicros();
+		_fakeMixerManager->update();
+		_benchmarkMixerTime += getBenchmarkMicros() - start;
+	} else {
+		_fakeMixerManager->update();
+	}
 	_recordMode = oldRecordMode;
 }
 
@@ -699,6 +731,17 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark && _initialized) {
+		// Everything since the previous screen update, except for the mixer, is engine time.
+		// The control panel is not drawn, so that only the engine's own screen is measured.
+		uint64 now = getBenchmarkMicros();
+		uint64 tick = now - _benchmarkFrameEnd;
+		_benchmarkTickTimes.push_back(tick > _benchmarkMixerTime ? tick - _benchmarkMixerTime : 0);
+		_benchmarkMixerTimes.push_back(_benchmarkMixerTime);
+		_benchmarkMixerTime = 0;
+		_benchmarkFrameStart = now;
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -716,6 +759,11 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark && _initialized) {
+		_benchmarkFrameEnd = getBenchmarkMicros();
+		_benchmarkBlitTimes.push_back(_benchmarkFrameEnd - _benchmarkFrameStart);
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -816,6 +864,92 @@ void EventRecorder::deleteTemporarySave() {
 	_temporarySlot = -1;
 }
 
+Common::RecorderEvent EventRecorder::getNextPlaybackEvent() {
+	// The playback file quits the application once it runs out of events
+	if (_benchmark && !_playbackFile->hasNextEvent()) {
+		writeBenchmarkReport();
+	}
+	return _playbackFile->getNextEvent();
+}
+
+uint64 EventRecorder::getBenchmarkMicros() const {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
+static Common::JSONValue *benchmarkTimings(Common::Array<uint32> times) {
+	Common::JSONObject result;
+	uint64 total = 0;
+	for (uint i = 0; i < times.size(); i++) {
+		total += times[i];
+	}
+	Common::sort(times.begin(), times.end());
+
+	const double usToMs = 1.0 / 1000.0;
+	result.setVal("totalMs", new Common::JSONValue(total * usToMs));
+	if (!times.empty()) {
+		result.setVal("meanMs", new Common::JSONValue(total * usToMs / times.size()));
+		result.setVal("minMs", new Common::JSONValue(times.front() * usToMs));
+		result.setVal("p50Ms", new Common::JSONValue(times[times.size() * 50 / 100] * usToMs));
+		result.setVal("p95Ms", new Common::JSONValue(times[times.size() * 95 / 100] * usToMs));
+		result.setVal("p99Ms", new Common::JSONValue(times[times.size() * 99 / 100] * usToMs));
+		result.setVal("maxMs", new Common::JSONValue(times.back() * usToMs));
+	}
+	return new Common::JSONValue(result);
+}
+
+void EventRecorder::writeBenchmarkReport() {
+	if (!_benchmark) {
+		return;
+	}
+	// Only report once, the playback file might run out of events while shutting down
+	_benchmark = false;
+
+	Common::JSONObject report;
+	report.setVal("recording", new Common::JSONValue(_recordFileName));
+	report.setVal("target", new Common::JSONValue(ConfMan.getActiveDomainName()));
+	report.setVal("engine", new Common::JSONValue(ConfMan.get("engineid")));
+	report.setVal("frames", new Common::JSONValue((long long int)_benchmarkBlitTimes.size()));
+	report.setVal("replayedMs", new Common::JSONValue((long long int)_fakeTimer));
+	report.setVal("wallMs", new Common::JSONValue((getBenchmarkMicros() - _benchmarkStart) / 1000.0));
+	report.setVal("engineTick", benchmarkTimings(_benchmarkTickTimes));
+	report.setVal("blit", benchmarkTimings(_benchmarkBlitTimes));
+	report.setVal("mixer", benchmarkTimings(_benchmarkMixerTimes));
+
+#if defined(POSIX)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef MACOSX
+		// macOS reports bytes instead of kilobytes
+		report.setVal("peakRssKb", new Common::JSONValue((long long int)usage.ru_maxrss / 1024));
+#else
+		report.setVal("peakRssKb", new Common::JSONValue((long long int)usage.ru_maxrss));
+#endif
+	}
+#endif
+
+	Common::JSONValue value(report);
+	Common::String json = value.stringify(true);
+
+	Common::Path reportPath = Common::Path::fromConfig(ConfMan.get("benchmark_report"));
+	Common::DumpFile file;
+	if (!file.open(reportPath, true)) {
+		warning("playback:action=error reason=\"Cannot write benchmark report %s\"", reportPath.toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+	file.writeString(json);
+	file.writeByte('\n');
+	file.finalize();
+	file.close();
+
+	debugC(1, kDebugLevelEventRec, "playback:action=\"Benchmark report\" filename=%s frames=%u", reportPath.toString(Common::Path::kNativeSeparator).c_str(), _benchmarkBlitTimes.size());
+}
+
 } // End of namespace GUI
 
 #endif // ENABLE_EVENTRECORDER
@@ -227,6 +227,11 @@ private:
 
 	bool checkGameHash(const ADGameDescription *desc);
 
+	Common::RecorderEvent getNextPlaybackEvent();
+
+	uint64 getBenchmarkMicros() const;
+	void writeBenchmarkReport();
+
 	void checkForKeyCode(const Common::Event &event);
 	/**
 	 * @return false because we don't want to remap the given event again. This already happened on
@@ -249,6 +254,16 @@ private:
 	bool _fastPlayback;
 	bool _needRedraw;
 	bool _processingMillis;
+
+	/** Benchmark mode: fast playback which collects frame timings in microseconds */
+	bool _benchmark;
+	uint64 _benchmarkStart;
+	uint64 _benchmarkFrameStart;
+	uint64 _benchmarkFrameEnd;
+	uint32 _benchmarkMixerTime;
+	Common::Array<uint32> _benchmarkTickTimes;
+	Common::Array<uint32> _benchmarkBlitTimes;
+	Common::Array<uint32> _benchmarkMixerTimes;
 };
 
 } // End of namespace GUI
@@ -76,6 +76,7 @@ Debugger::Debugger() {
 	registerCmd("clear",			WRAP_METHOD(Debugger, cmdClearLog));
 	registerCmd("cls",			WRAP_METHOD(Debugger, cmdClearLog)); // alias
 	registerCmd("exec",				WRAP_METHOD(Debugger, cmdExecFile));
+	registerCmd("archive_cache",	WRAP_METHOD(Debugger, cmdArchiveCache));
 
 	registerCmd("debuglevel",		WRAP_METHOD(Debugger, cmdDebugLevel));
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
@@ -819,6 +820,22 @@ bool Debugger::cmdClearLog(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdArchiveCache(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	Common::MemcachingCaseInsensitiveArchive::CacheStats stats = Common::MemcachingCaseInsensitiveArchive::getSharedCacheStats();
+	debugPrintf("Archive member cache: %u / %u bytes used\n", stats.usedBytes, stats.budget);
+	debugPrintf("  hits: %u, misses: %u, evictions: %u\n", stats.hits, stats.misses, stats.evictions);
+
+	if (argc == 2)
+		Common::MemcachingCaseInsensitiveArchive::resetSharedCacheStats();
+
+	return true;
+}
+
 bool Debugger::cmdExecFile(int argc, const char **argv) {
 	if (argc <= 1) {
 		debugPrintf("Expected to get the file with debug commands\n");
@@ -188,8 +188,9 @@ void MassAddDialog::handleTickle() {
 		return;	// We have finished scanning
 
 	uint32 t = g_system->getMillis();
+	uint oldGamesSize = _games.size();
 
-	// Perform a breadth-first scan of the filesystem.
+	// Perform a depth-first scan of the filesystem.
 	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
 		Common::FSNode dir = _scanStack.pop();
 
@@ -245,16 +246,9 @@ void MassAddDialog::handleTickle() {
 				}
 			}
 			_games.push_back(result);
-
-			_list->append(result.description);
-		}
-
-		for (DetectedGame &game : _games) {
-			game.isSelected = true;
+			_games.back().isSelected = true;
 		}
 
-		updateGameList();
-
 		// Recurse into all subdirs
 		for (const auto &file : files) {
 			if (file.isDirectory()) {
@@ -273,6 +267,11 @@ void MassAddDialog::handleTickle() {
 	}
 
 
+	// Only rebuild the list once per tickle, and only when something was found,
+	// as doing it for every directory dominates the scan time for large trees.
+	if (_games.size() != oldGamesSize)
+		updateGameList();
+
 	// Update the dialog
 	Common::U32String buf;
 
@@ -294,7 +293,7 @@ void MassAddDialog::handleTickle() {
 		_gameProgressText->setLabel(buf);
 	}
 
-	if (_games.size() > 0) {
+	if (_games.size() != oldGamesSize) {
 		_list->scrollToEnd();
 	}
 
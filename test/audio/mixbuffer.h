@@ -0,0 +1,95 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixbuffer.h"
+
+#include "../instrset_detect.h"
+
+class MixBufferTestSuite : public CxxTest::TestSuite {
+	typedef void(*MixFunc)(int32 *, const Audio::st_sample_t *, uint, Audio::st_volume_t, Audio::st_volume_t);
+	typedef void(*SaturateFunc)(Audio::st_sample_t *, const int32 *, uint);
+
+	enum {
+		kNumFrames = 67
+	};
+
+	Audio::st_sample_t _frames[kNumFrames * 2];
+	int32 _bus[kNumFrames * 2];
+
+	void fillFrames() {
+		uint32 seed = 0x1234;
+		for (int i = 0; i < kNumFrames * 2; i++) {
+			seed = seed * 1103515245 + 12345;
+			_frames[i] = (Audio::st_sample_t)(seed >> 16);
+		}
+		// Make sure the extremes are covered
+		_frames[0] = -32768;
+		_frames[1] = 32767;
+	}
+
+	void fillBus() {
+		for (int i = 0; i < kNumFrames * 2; i++)
+			_bus[i] = (i * 7919) % 200000 - 100000;
+	}
+
+	void compareMix(MixFunc func, MixFunc generic, uint channels) {
+		static const Audio::st_volume_t volumes[][2] = { { 256, 256 }, { 0, 256 }, { 255, 17 }, { 128, 1 } };
+
+		fillFrames();
+		for (int v = 0; v < ARRAYSIZE(volumes); v++) {
+			int32 expected[kNumFrames * 2];
+			fillBus();
+			generic(_bus, _frames, kNumFrames, volumes[v][0], volumes[v][1]);
+			memcpy(expected, _bus, sizeof(expected));
+
+			fillBus();
+			func(_bus, _frames, kNumFrames, volumes[v][0], volumes[v][1]);
+			TS_ASSERT_EQUALS(memcmp(expected, _bus, kNumFrames * channels * sizeof(int32)), 0);
+		}
+	}
+
+	void compareSaturate(SaturateFunc func) {
+		Audio::st_sample_t expected[kNumFrames * 2], result[kNumFrames * 2];
+		fillBus();
+		Audio::MixBuffer::saturateGeneric(expected, _bus, kNumFrames * 2);
+		func(result, _bus, kNumFrames * 2);
+		TS_ASSERT_EQUALS(memcmp(expected, result, sizeof(expected)), 0);
+	}
+
+	void compareAll(MixFunc mixStereo, MixFunc mixMono, SaturateFunc saturate) {
+		compareMix(mixStereo, Audio::MixBuffer::mixStereoGeneric, 2);
+		compareMix(mixMono, Audio::MixBuffer::mixMonoGeneric, 1);
+		compareSaturate(saturate);
+	}
+
+public:
+	void test_generic() {
+		// Full volume leaves the samples as they are
+		fillFrames();
+		memset(_bus, 0, sizeof(_bus));
+		Audio::MixBuffer::mixStereoGeneric(_bus, _frames, kNumFrames, 256, 256);
+		for (int i = 0; i < kNumFrames * 2; i++)
+			TS_ASSERT_EQUALS(_bus[i], _frames[i]);
+
+		// Saturation only happens once everything has been mixed
+		int32 bus[4] = { 40000, -40000, 40000 - 20000, -32769 };
+		Audio::st_sample_t out[4];
+		Audio::MixBuffer::saturateGeneric(out, bus, 4);
+#ifndef OUTPUT_UNSIGNED_AUDIO
+		TS_ASSERT_EQUALS(out[0], 32767);
+		TS_ASSERT_EQUALS(out[1], -32768);
+		TS_ASSERT_EQUALS(out[2], 20000);
+		TS_ASSERT_EQUALS(out[3], -32768);
+#endif
+	}
+
+	void test_simd() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			compareAll(Audio::MixBuffer::mixStereoSSE2, Audio::MixBuffer::mixMonoSSE2, Audio::MixBuffer::saturateSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			compareAll(Audio::MixBuffer::mixStereoAVX2, Audio::MixBuffer::mixMonoAVX2, Audio::MixBuffer::saturateAVX2);
+#endif
+	}
+};
@@ -0,0 +1,198 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixbuffer.h"
+#include "audio/mixer_intern.h"
+
+#include "../null_osystem.h"
+
+class DeferredMixerTestSuite : public CxxTest::TestSuite {
+	// Endless stream of a constant sample, which tells when it is read or deleted
+	class TestStream : public Audio::AudioStream {
+	public:
+		TestStream(bool &deleted, int &samplesRead) : _deleted(deleted), _samplesRead(samplesRead) {
+			_deleted = false;
+			_samplesRead = 0;
+		}
+		~TestStream() override { _deleted = true; }
+
+		int readBuffer(int16 *buffer, const int numSamples) override {
+			for (int i = 0; i < numSamples; i++)
+				buffer[i] = 1000;
+			_samplesRead += numSamples;
+			return numSamples;
+		}
+
+		bool isStereo() const override { return false; }
+		int getRate() const override { return 22050; }
+		bool endOfData() const override { return false; }
+
+	private:
+		bool &_deleted;
+		int &_samplesRead;
+	};
+
+	// Starts another sound the first time it is mixed
+	class StarterStream : public TestStream {
+	public:
+		StarterStream(Audio::MixerImpl *mixer, Audio::AudioStream *stream, bool &deleted, int &samplesRead) :
+			TestStream(deleted, samplesRead), _mixer(mixer), _stream(stream) {}
+		~StarterStream() override { delete _stream; }
+
+		int readBuffer(int16 *buffer, const int numSamples) override {
+			if (_stream) {
+				_mixer->playStream(Audio::Mixer::kPlainSoundType, nullptr, _stream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::YES, false, false);
+				_stream = nullptr;
+			}
+			return TestStream::readBuffer(buffer, numSamples);
+		}
+
+	private:
+		Audio::MixerImpl *_mixer;
+		Audio::AudioStream *_stream;
+	};
+
+	Audio::MixerImpl *createMixer(uint outBufSize = 0) {
+		Common::install_null_g_system();
+
+		// The null backend has no graphics manager to answer CPU feature queries
+		Audio::MixBuffer::mixStereoFunc = Audio::MixBuffer::mixStereoGeneric;
+		Audio::MixBuffer::mixMonoFunc = Audio::MixBuffer::mixMonoGeneric;
+		Audio::MixBuffer::saturateFunc = Audio::MixBuffer::saturateGeneric;
+
+		Audio::MixerImpl *mixer = new Audio::MixerImpl(22050, true, outBufSize);
+		mixer->setDeferredCommands(true);
+		mixer->setReady(true);
+		return mixer;
+	}
+
+	void play(Audio::MixerImpl *mixer, Audio::SoundHandle *handle, Audio::AudioStream *stream, int id = -1) {
+		mixer->playStream(Audio::Mixer::kPlainSoundType, handle, stream, id, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::YES, false, false);
+	}
+
+	void mix(Audio::MixerImpl *mixer) {
+		int16 buffer[512];
+		mixer->mixCallback((byte *)buffer, sizeof(buffer));
+	}
+
+public:
+	void test_stop_handle_is_immediate() {
+		Audio::MixerImpl *mixer = createMixer();
+		bool deleted;
+		int samplesRead;
+
+		Audio::SoundHandle handle;
+		play(mixer, &handle, new TestStream(deleted, samplesRead));
+		mix(mixer);
+		TS_ASSERT(samplesRead > 0);
+
+		// A command still pending must not keep the channel alive
+		mixer->setChannelVolume(handle, 100);
+		mixer->stopHandle(handle);
+		TS_ASSERT(deleted);
+		TS_ASSERT(!mixer->isSoundHandleActive(handle));
+
+		// Commands for the stopped sound are ignored
+		mixer->setChannelVolume(handle, 10);
+		mix(mixer);
+
+		delete mixer;
+	}
+
+	void test_stop_id_is_immediate() {
+		Audio::MixerImpl *mixer = createMixer();
+		bool deleted1, deleted2;
+		int samplesRead1, samplesRead2;
+
+		Audio::SoundHandle handle1, handle2;
+		play(mixer, &handle1, new TestStream(deleted1, samplesRead1), 1);
+		play(mixer, &handle2, new TestStream(deleted2, samplesRead2), 2);
+
+		mixer->pauseID(1, true);
+		mixer->stopID(1);
+		TS_ASSERT(deleted1);
+		TS_ASSERT(!deleted2);
+		TS_ASSERT(!mixer->isSoundIDActive(1));
+		TS_ASSERT(mixer->isSoundIDActive(2));
+
+		mix(mixer);
+		TS_ASSERT(samplesRead2 > 0);
+
+		delete mixer;
+	}
+
+	void test_commands_keep_order() {
+		Audio::MixerImpl *mixer = createMixer();
+		bool deleted;
+		int samplesRead;
+
+		Audio::SoundHandle handle;
+		play(mixer, &handle, new TestStream(deleted, samplesRead));
+
+		// Queries see posted commands right away
+		mixer->setChannelVolume(handle, 10);
+		mixer->setChannelVolume(handle, 20);
+		TS_ASSERT_EQUALS(mixer->getChannelVolume(handle), 20);
+
+		// Paused, then resumed before the mixer ran: the sound plays
+		mixer->pauseHandle(handle, true);
+		mixer->pauseHandle(handle, false);
+		mix(mixer);
+		TS_ASSERT(samplesRead > 0);
+		TS_ASSERT_EQUALS(mixer->getChannelVolume(handle), 20);
+
+		// Resumed, then paused again: the sound does not play
+		mixer->pauseHandle(handle, true);
+		mix(mixer);
+		int pausedRead = samplesRead;
+		mix(mixer);
+		TS_ASSERT_EQUALS(samplesRead, pausedRead);
+
+		// Stopping applies the pending commands first
+		mixer->pauseHandle(handle, false);
+		mixer->stopHandle(handle);
+		TS_ASSERT(deleted);
+
+		delete mixer;
+	}
+
+	void test_sound_started_while_mixing_waits() {
+		Audio::MixerImpl *mixer = createMixer();
+		bool deleted1, deleted2;
+		int samplesRead1, samplesRead2;
+
+		TestStream *started = new TestStream(deleted2, samplesRead2);
+		Audio::SoundHandle handle;
+		play(mixer, &handle, new StarterStream(mixer, started, deleted1, samplesRead1));
+
+		// The new sound gets a later channel, but is only mixed from the next call on
+		mix(mixer);
+		TS_ASSERT(samplesRead1 > 0);
+		TS_ASSERT_EQUALS(samplesRead2, 0);
+		mix(mixer);
+		TS_ASSERT(samplesRead2 > 0);
+
+		delete mixer;
+		TS_ASSERT(deleted1);
+		TS_ASSERT(deleted2);
+	}
+
+	void test_large_request_is_mixed_in_pieces() {
+		// Smaller than the request, so the callback has to mix it in several passes
+		Audio::MixerImpl *mixer = createMixer(100);
+		bool deleted;
+		int samplesRead;
+
+		Audio::SoundHandle handle;
+		play(mixer, &handle, new TestStream(deleted, samplesRead));
+
+		int16 buffer[1024];
+		TS_ASSERT_EQUALS(mixer->mixCallback((byte *)buffer, sizeof(buffer)), 512);
+		TS_ASSERT_EQUALS(samplesRead, 512);
+		TS_ASSERT_DIFFERS(buffer[0], 0);
+		for (int i = 1; i < 1024; i++)
+			TS_ASSERT_EQUALS(buffer[i], buffer[0]);
+
+		delete mixer;
+	}
+};
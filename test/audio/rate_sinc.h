@@ -0,0 +1,157 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/rate_sinc.h"
+
+#include "helper.h"
+#include "../instrset_detect.h"
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class SincFilterTestSuite : public CxxTest::TestSuite {
+	typedef void(*FilterFunc)(Audio::st_sample_t *, const Audio::st_sample_t *, const int16 *, uint32, uint32, uint);
+
+	void compareFilter(FilterFunc func) {
+		const int numInput = 256;
+		const int numOutput = 200;
+
+		int16 *table = new int16[Audio::SincFilter::kNumPhases * Audio::SincFilter::kNumTaps];
+		Audio::SincFilter::makeTable(table, 0.9);
+
+		Audio::st_sample_t input[numInput];
+		uint32 seed = 0x5678;
+		for (int i = 0; i < numInput; i++) {
+			seed = seed * 1103515245 + 12345;
+			input[i] = (Audio::st_sample_t)(seed >> 16);
+		}
+		input[20] = input[21] = input[22] = 32767;
+		input[40] = input[41] = input[42] = -32768;
+
+		// Ratio of 11025 to 48000 Hz
+		const uint32 step = (uint32)(((uint64)11025 << Audio::SincFilter::FRAC_BITS) / 48000);
+
+		Audio::st_sample_t expected[numOutput * 2], result[numOutput * 2];
+		memset(expected, 0, sizeof(expected));
+		memset(result, 0, sizeof(result));
+		Audio::SincFilter::filterGeneric(expected, input, table, 0, step, numOutput);
+		func(result, input, table, 0, step, numOutput);
+		TS_ASSERT_EQUALS(memcmp(expected, result, sizeof(expected)), 0);
+
+		delete[] table;
+	}
+
+	void selectFilter() {
+		Audio::SincFilter::filterFunc = Audio::SincFilter::filterGeneric;
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			Audio::SincFilter::filterFunc = Audio::SincFilter::filterSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			Audio::SincFilter::filterFunc = Audio::SincFilter::filterAVX2;
+#endif
+	}
+
+public:
+	void test_table() {
+		int16 *table = new int16[Audio::SincFilter::kNumPhases * Audio::SincFilter::kNumTaps];
+		Audio::SincFilter::makeTable(table, 1.0);
+
+		// Every phase has unity gain
+		for (int phase = 0; phase < Audio::SincFilter::kNumPhases; phase++) {
+			int sum = 0;
+			for (int k = 0; k < Audio::SincFilter::kNumTaps; k++)
+				sum += table[phase * Audio::SincFilter::kNumTaps + k];
+			TS_ASSERT_EQUALS(sum, 1 << Audio::SincFilter::kCoefBits);
+		}
+
+		// Without any band limiting, phase zero is a unit impulse
+		for (int k = 0; k < Audio::SincFilter::kNumTaps; k++)
+			TS_ASSERT_EQUALS(table[k], k == Audio::SincFilter::kNumTaps / 2 - 1 ? 1 << Audio::SincFilter::kCoefBits : 0);
+
+		delete[] table;
+	}
+
+	void test_simd() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			compareFilter(Audio::SincFilter::filterSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			compareFilter(Audio::SincFilter::filterAVX2);
+#endif
+	}
+
+	void test_dc() {
+		selectFilter();
+
+		// A constant signal has to come out unchanged after the filter
+		// history has filled up
+		const int numInput = 4000;
+		int16 *data = (int16 *)malloc(numInput * 2 * sizeof(int16));
+		for (int i = 0; i < numInput * 2; i++)
+			data[i] = (i & 1) ? -12000 : 10000;
+		Audio::AudioStream *stream = Audio::makeRawStream((const byte *)data, numInput * 4, 11025, Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN);
+		Audio::RateConverter *converter = Audio::makeRateConverter(11025, 44100, true, true, false, Audio::kRateConverterSinc);
+
+		const int numOutput = 8000;
+		Audio::st_sample_t *output = new Audio::st_sample_t[numOutput * 2];
+		memset(output, 0, numOutput * 2 * sizeof(Audio::st_sample_t));
+		TS_ASSERT_EQUALS(converter->convert(*stream, output, numOutput, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), numOutput);
+		for (int i = 100; i < numOutput; i++) {
+			TS_ASSERT_EQUALS(output[i * 2], 10000);
+			TS_ASSERT_EQUALS(output[i * 2 + 1], -12000);
+		}
+
+		delete[] output;
+		delete converter;
+		delete stream;
+	}
+
+	void test_benchmark() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+		selectFilter();
+
+		const int rates[] = { 11025, 22050, 44100 };
+		const Audio::RateConverterQuality qualities[] = { Audio::kRateConverterLinear, Audio::kRateConverterSinc };
+		const char *names[] = { "linear", "sinc" };
+#ifdef SLOW_TESTS
+		const int seconds = 60;
+#else
+		const int seconds = 2;
+#endif
+		const int outRate = 48000;
+		const int chunk = 1024;
+		Audio::st_sample_t *output = new Audio::st_sample_t[chunk * 2];
+
+		for (int r = 0; r < ARRAYSIZE(rates); r++) {
+			for (int q = 0; q < ARRAYSIZE(qualities); q++) {
+				Audio::SeekableAudioStream *sine = createSineStream<int16>(rates[r], 1, nullptr, false, true);
+				Audio::AudioStream *stream = new Audio::LoopingAudioStream(sine, 0);
+				Audio::RateConverter *converter = Audio::makeRateConverter(rates[r], outRate, true, true, false, qualities[q]);
+
+				uint32 start = g_system->getMillis();
+				for (int i = 0; i < seconds * outRate / chunk; i++)
+					converter->convert(*stream, output, chunk, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+				uint32 time = g_system->getMillis() - start;
+
+				debug("Rate converter %s %d -> %d Hz: %u ms per %d seconds of stereo output", names[q], rates[r], outRate, time, seconds);
+
+				delete converter;
+				delete stream;
+			}
+		}
+
+		delete[] output;
+#endif
+	}
+};
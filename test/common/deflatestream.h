@@ -0,0 +1,98 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/compression/deflate.h"
+
+class DeflateStreamTestSuite : public CxxTest::TestSuite {
+	enum {
+		kDataSize = 3 * 1024 * 1024 + 1234
+	};
+
+	static byte expectedByte(uint32 pos) {
+		// Compressible, but not trivially, so that deflate emits many blocks
+		uint32 x = pos / 7;
+		x ^= x >> 13;
+		x *= 0x5bd1e995;
+		x ^= x >> 15;
+		return (byte)('a' + (x & 15) + (pos & 1));
+	}
+
+	Common::SeekableReadStream *createStream() {
+		Common::MemoryWriteStreamDynamic *memStream = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *compressed = Common::wrapCompressedWriteStream(memStream);
+
+		byte buf[4096];
+		for (uint32 pos = 0; pos < kDataSize; pos += sizeof(buf)) {
+			uint32 len = MIN<uint32>(sizeof(buf), kDataSize - pos);
+			for (uint32 i = 0; i < len; i++)
+				buf[i] = expectedByte(pos + i);
+			compressed->write(buf, len);
+		}
+		compressed->finalize();
+
+		byte *data = memStream->getData();
+		uint32 size = memStream->size();
+		delete compressed;
+
+		return Common::wrapCompressedReadStream(new Common::MemoryReadStream(data, size, DisposeAfterUse::YES), DisposeAfterUse::YES, kDataSize);
+	}
+
+	bool checkAt(Common::SeekableReadStream *stream, uint32 pos, uint32 len) {
+		if (!stream->seek(pos) || stream->pos() != pos)
+			return false;
+
+		byte buf[256];
+		assert(len <= sizeof(buf));
+		if (stream->read(buf, len) != len)
+			return false;
+
+		for (uint32 i = 0; i < len; i++) {
+			if (buf[i] != expectedByte(pos + i))
+				return false;
+		}
+		return true;
+	}
+
+public:
+	void test_sequential() {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(createStream());
+		TS_ASSERT_EQUALS(stream->size(), kDataSize);
+
+		byte buf[4096];
+		uint32 pos = 0;
+		bool ok = true;
+		while (pos < kDataSize) {
+			uint32 len = stream->read(buf, sizeof(buf));
+			if (len == 0)
+				break;
+			for (uint32 i = 0; i < len; i++)
+				ok = ok && (buf[i] == expectedByte(pos + i));
+			pos += len;
+		}
+		TS_ASSERT(ok);
+		TS_ASSERT_EQUALS(pos, (uint32)kDataSize);
+	}
+
+	void test_seek() {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(createStream());
+
+		// Forward first, so that the checkpoints get recorded
+		TS_ASSERT(checkAt(stream.get(), 100, 16));
+		TS_ASSERT(checkAt(stream.get(), kDataSize - 200, 200));
+
+		// Then backwards, which resumes from the checkpoints
+		TS_ASSERT(checkAt(stream.get(), 2 * 1024 * 1024 + 17, 256));
+		TS_ASSERT(checkAt(stream.get(), 1024 * 1024 - 3, 256));
+		TS_ASSERT(checkAt(stream.get(), 3 * 1024 * 1024, 256));
+		TS_ASSERT(checkAt(stream.get(), 5, 100));
+		TS_ASSERT(checkAt(stream.get(), 1536 * 1024, 256));
+		TS_ASSERT(checkAt(stream.get(), 1536 * 1024 - 256, 256));
+
+		// And reading up to the end still works from a checkpoint
+		stream->seek(kDataSize - 10);
+		byte buf[20];
+		TS_ASSERT_EQUALS(stream->read(buf, sizeof(buf)), 10u);
+		TS_ASSERT(stream->eos());
+	}
+};
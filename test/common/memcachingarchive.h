@@ -0,0 +1,109 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/stream.h"
+
+class TestMemcachingArchive : public Common::MemcachingCaseInsensitiveArchive {
+public:
+	TestMemcachingArchive() : Common::MemcachingCaseInsensitiveArchive(16), reads(0) {}
+
+	bool hasFile(const Common::Path &path) const override { return true; }
+	int listMembers(Common::ArchiveMemberList &list) const override { return 0; }
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override { return Common::ArchiveMemberPtr(); }
+
+	Common::SharedArchiveContents readContentsForPath(const Common::Path &translatedPath) const override {
+		reads++;
+
+		// Member names are their size in bytes
+		uint32 size = atoi(translatedPath.toString().c_str());
+		byte *data = new byte[size];
+		memset(data, size & 0xff, size);
+		return Common::SharedArchiveContents(data, size);
+	}
+
+	mutable int reads;
+};
+
+class MemcachingArchiveTestSuite : public CxxTest::TestSuite {
+public:
+	void tearDown() {
+		Common::MemcachingCaseInsensitiveArchive::setSharedCacheBudget(0);
+		Common::MemcachingCaseInsensitiveArchive::resetSharedCacheStats();
+	}
+
+	void test_no_shared_cache() {
+		Common::MemcachingCaseInsensitiveArchive::setSharedCacheBudget(0);
+		TestMemcachingArchive archive;
+
+		// Big members are read again once their last stream is gone
+		delete archive.createReadStreamForMember("1000");
+		delete archive.createReadStreamForMember("1000");
+		TS_ASSERT_EQUALS(archive.reads, 2);
+
+		// Small members are always kept
+		delete archive.createReadStreamForMember("10");
+		delete archive.createReadStreamForMember("10");
+		TS_ASSERT_EQUALS(archive.reads, 3);
+	}
+
+	void test_shared_cache_hits() {
+		Common::MemcachingCaseInsensitiveArchive::setSharedCacheBudget(4096);
+		Common::MemcachingCaseInsensitiveArchive::resetSharedCacheStats();
+		TestMemcachingArchive archive;
+
+		Common::SeekableReadStream *stream = archive.createReadStreamForMember("1000");
+		TS_ASSERT_EQUALS(stream->size(), 1000);
+		TS_ASSERT_EQUALS(stream->readByte(), 1000 & 0xff);
+		delete stream;
+
+		delete archive.createReadStreamForMember("1000");
+		delete archive.createReadStreamForMember("1000");
+		TS_ASSERT_EQUALS(archive.reads, 1);
+
+		Common::MemcachingCaseInsensitiveArchive::CacheStats stats = Common::MemcachingCaseInsensitiveArchive::getSharedCacheStats();
+		TS_ASSERT_EQUALS(stats.misses, 1u);
+		TS_ASSERT_EQUALS(stats.hits, 2u);
+		TS_ASSERT_EQUALS(stats.evictions, 0u);
+		TS_ASSERT_EQUALS(stats.usedBytes, 1000u);
+	}
+
+	void test_shared_cache_eviction() {
+		Common::MemcachingCaseInsensitiveArchive::setSharedCacheBudget(2500);
+		Common::MemcachingCaseInsensitiveArchive::resetSharedCacheStats();
+		TestMemcachingArchive archive;
+
+		delete archive.createReadStreamForMember("1000");
+		delete archive.createReadStreamForMember("1001");
+		// Touch the first member so that the second one is the oldest
+		delete archive.createReadStreamForMember("1000");
+		delete archive.createReadStreamForMember("1002");
+		TS_ASSERT_EQUALS(archive.reads, 3);
+
+		Common::MemcachingCaseInsensitiveArchive::CacheStats stats = Common::MemcachingCaseInsensitiveArchive::getSharedCacheStats();
+		TS_ASSERT_EQUALS(stats.evictions, 1u);
+		TS_ASSERT_EQUALS(stats.usedBytes, 2002u);
+
+		delete archive.createReadStreamForMember("1000");
+		delete archive.createReadStreamForMember("1002");
+		TS_ASSERT_EQUALS(archive.reads, 3);
+
+		delete archive.createReadStreamForMember("1001");
+		TS_ASSERT_EQUALS(archive.reads, 4);
+
+		// Members bigger than the whole budget are never kept
+		delete archive.createReadStreamForMember("3000");
+		delete archive.createReadStreamForMember("3000");
+		TS_ASSERT_EQUALS(archive.reads, 6);
+	}
+
+	void test_shared_cache_archive_destruction() {
+		Common::MemcachingCaseInsensitiveArchive::setSharedCacheBudget(4096);
+
+		TestMemcachingArchive *archive = new TestMemcachingArchive();
+		delete archive->createReadStreamForMember("1000");
+		TS_ASSERT_EQUALS(Common::MemcachingCaseInsensitiveArchive::getSharedCacheStats().usedBytes, 1000u);
+
+		delete archive;
+		TS_ASSERT_EQUALS(Common::MemcachingCaseInsensitiveArchive::getSharedCacheStats().usedBytes, 0u);
+	}
+};
@@ -0,0 +1,205 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/crc.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/compression/unzip.h"
+
+class ZipArchiveTestSuite : public CxxTest::TestSuite {
+	enum {
+		// Bigger than the members unzip loads into memory at once
+		kDataSize = 5 * 1024 * 1024 + 1234,
+		kStoredBlockSize = 65535
+	};
+
+	struct Member {
+		const char *name;
+		uint16 method;
+		uint32 crc;
+		uint32 compressedSize;
+		uint32 offset;
+	};
+
+	static byte expectedByte(uint32 pos) {
+		uint32 x = pos / 3;
+		x ^= x >> 11;
+		x *= 0x2545f491;
+		return (byte)(x >> 24);
+	}
+
+	static void writeData(Common::WriteStream &out, uint32 pos, uint32 len) {
+		byte buf[4096];
+		while (len > 0) {
+			uint32 chunk = MIN<uint32>(sizeof(buf), len);
+			for (uint32 i = 0; i < chunk; i++)
+				buf[i] = expectedByte(pos + i);
+			out.write(buf, chunk);
+			pos += chunk;
+			len -= chunk;
+		}
+	}
+
+	static void writeLocalHeader(Common::WriteStream &out, const Member &member) {
+		out.writeUint32LE(0x04034b50);
+		out.writeUint16LE(20);       // version needed
+		out.writeUint16LE(0);        // flags
+		out.writeUint16LE(member.method);
+		out.writeUint32LE(0);        // date and time
+		out.writeUint32LE(member.crc);
+		out.writeUint32LE(member.compressedSize);
+		out.writeUint32LE(kDataSize);
+		out.writeUint16LE(strlen(member.name));
+		out.writeUint16LE(0);        // extra field
+		out.writeString(member.name);
+	}
+
+	static void writeCentralHeader(Common::WriteStream &out, const Member &member) {
+		out.writeUint32LE(0x02014b50);
+		out.writeUint16LE(20);       // version made by
+		out.writeUint16LE(20);       // version needed
+		out.writeUint16LE(0);        // flags
+		out.writeUint16LE(member.method);
+		out.writeUint32LE(0);        // date and time
+		out.writeUint32LE(member.crc);
+		out.writeUint32LE(member.compressedSize);
+		out.writeUint32LE(kDataSize);
+		out.writeUint16LE(strlen(member.name));
+		out.writeUint16LE(0);        // extra field
+		out.writeUint16LE(0);        // comment
+		out.writeUint16LE(0);        // disk number
+		out.writeUint16LE(0);        // internal attributes
+		out.writeUint32LE(0);        // external attributes
+		out.writeUint32LE(member.offset);
+		out.writeString(member.name);
+	}
+
+	// The deflated member uses stored blocks only, which any inflater reads
+	static void writeDeflated(Common::WriteStream &out) {
+		for (uint32 pos = 0; pos < kDataSize; pos += kStoredBlockSize) {
+			uint16 len = MIN<uint32>(kStoredBlockSize, kDataSize - pos);
+			out.writeByte(pos + len == kDataSize ? 1 : 0);
+			out.writeUint16LE(len);
+			out.writeUint16LE(~len);
+			writeData(out, pos, len);
+		}
+	}
+
+	Common::Archive *createArchive() {
+		Common::CRC32 crc;
+		byte *data = new byte[kDataSize];
+		for (uint32 i = 0; i < kDataSize; i++)
+			data[i] = expectedByte(i);
+		uint32 dataCrc = crc.crcFast(data, kDataSize);
+		delete[] data;
+
+		const uint32 numBlocks = (kDataSize + kStoredBlockSize - 1) / kStoredBlockSize;
+		Member members[] = {
+			{ "stored.bin", 0, dataCrc, kDataSize, 0 },
+			{ "deflated.bin", 8, dataCrc, kDataSize + numBlocks * 5, 0 },
+			{ "corrupt.bin", 0, dataCrc ^ 1, kDataSize, 0 }
+		};
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::NO);
+		for (uint i = 0; i < ARRAYSIZE(members); i++) {
+			members[i].offset = out.pos();
+			writeLocalHeader(out, members[i]);
+			if (members[i].method == 8)
+				writeDeflated(out);
+			else
+				writeData(out, 0, kDataSize);
+		}
+
+		uint32 centralDirOffset = out.pos();
+		for (uint i = 0; i < ARRAYSIZE(members); i++)
+			writeCentralHeader(out, members[i]);
+		uint32 centralDirSize = out.pos() - centralDirOffset;
+
+		out.writeUint32LE(0x06054b50);
+		out.writeUint16LE(0);        // disk number
+		out.writeUint16LE(0);        // disk with the central directory
+		out.writeUint16LE(ARRAYSIZE(members));
+		out.writeUint16LE(ARRAYSIZE(members));
+		out.writeUint32LE(centralDirSize);
+		out.writeUint32LE(centralDirOffset);
+		out.writeUint16LE(0);        // comment
+
+		return Common::makeZipArchive(new Common::MemoryReadStream(out.getData(), out.size(), DisposeAfterUse::YES));
+	}
+
+	bool checkAt(Common::SeekableReadStream *stream, uint32 pos, uint32 len) {
+		if (!stream->seek(pos) || stream->pos() != pos)
+			return false;
+
+		byte buf[256];
+		assert(len <= sizeof(buf));
+		if (stream->read(buf, len) != len)
+			return false;
+
+		for (uint32 i = 0; i < len; i++) {
+			if (buf[i] != expectedByte(pos + i))
+				return false;
+		}
+		return true;
+	}
+
+	bool readToEnd(Common::SeekableReadStream *stream) {
+		byte buf[4096];
+		uint32 pos = stream->pos();
+		while (!stream->eos()) {
+			uint32 len = stream->read(buf, sizeof(buf));
+			for (uint32 i = 0; i < len; i++) {
+				if (buf[i] != expectedByte(pos + i))
+					return false;
+			}
+			pos += len;
+		}
+		return pos == kDataSize;
+	}
+
+	// Opens a member and then drops the archive it belongs to
+	Common::SeekableReadStream *openMember(const char *name) {
+		Common::Archive *archive = createArchive();
+		if (!archive)
+			return nullptr;
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember(name);
+		delete archive;
+		return stream;
+	}
+
+	void checkMember(const char *name) {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(openMember(name));
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+		TS_ASSERT_EQUALS(stream->size(), kDataSize);
+
+		TS_ASSERT(checkAt(stream.get(), kDataSize - 100, 100));
+		TS_ASSERT(checkAt(stream.get(), 10, 200));
+		TS_ASSERT(checkAt(stream.get(), 4 * 1024 * 1024 + 17, 256));
+		TS_ASSERT(checkAt(stream.get(), 1000, 10));
+
+		stream->seek(0);
+		TS_ASSERT(readToEnd(stream.get()));
+		TS_ASSERT(!stream->err());
+	}
+
+public:
+	void test_stored_member_outlives_archive() {
+		checkMember("stored.bin");
+	}
+
+	void test_deflated_member_outlives_archive() {
+		checkMember("deflated.bin");
+	}
+
+	void test_crc_checked_at_end() {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(openMember("corrupt.bin"));
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT(readToEnd(stream.get()));
+		TS_ASSERT(stream->err());
+	}
+};
@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+#include "engines/savemetaindex.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "../null_osystem.h"
+
+class SaveMetaIndexTestSuite : public CxxTest::TestSuite {
+	Common::Path _directory;
+
+	// Start every test from an empty index for the target
+	void clearIndex(const Common::String &target) {
+		Common::FSNode directory(_directory);
+		if (!directory.exists())
+			TS_ASSERT(directory.createDirectory());
+
+		Common::FSNode node(_directory.appendComponent(target + ".saveindex"));
+		Common::ScopedPtr<Common::WriteStream> out(node.createWriteStream());
+		TS_ASSERT(out);
+	}
+
+	static SaveMetaIndex::Entry makeEntry(int64 size, int64 mtime, const Common::String &description) {
+		SaveMetaIndex::Entry entry;
+		entry.size = size;
+		entry.mtime = mtime;
+		entry.valid = true;
+		entry.date = 0x12345678;
+		entry.time = 0x1234;
+		entry.playtime = 987654;
+		entry.description = description;
+		return entry;
+	}
+
+public:
+	void setUp() {
+		Common::install_null_g_system();
+		_directory = Common::Path("saveindex-test");
+	}
+
+	void test_round_trip() {
+		clearIndex("roundtrip");
+
+		// Longer than the 255 bytes a length byte could hold
+		Common::String description;
+		for (int i = 0; i < 300; i++)
+			description += (char)('a' + i % 26);
+
+		SaveMetaIndex::Entry entry = makeEntry(1234, 5678, description);
+		entry.isAutosave = true;
+
+		Graphics::Surface *thumbnail = new Graphics::Surface();
+		thumbnail->create(4, 3, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		for (int y = 0; y < thumbnail->h; y++)
+			for (int x = 0; x < thumbnail->w; x++)
+				*(uint16 *)thumbnail->getBasePtr(x, y) = (uint16)(y * 0x1000 + x * 0x11);
+		entry.thumbnail = Common::SharedPtr<Graphics::Surface>(thumbnail, Graphics::SurfaceDeleter());
+
+		SaveMetaIndex::Entry invalid;
+		invalid.size = 42;
+		invalid.mtime = 43;
+
+		SaveMetaIndex writer(_directory);
+		writer.set("roundtrip", "roundtrip.001", entry);
+		writer.set("roundtrip", "roundtrip.002", invalid);
+		writer.release();
+
+		SaveMetaIndex reader(_directory);
+		const SaveMetaIndex::Entry *read = reader.find("roundtrip", "roundtrip.001", 1234, 5678);
+		TS_ASSERT(read);
+		if (read) {
+			TS_ASSERT(read->valid);
+			TS_ASSERT_EQUALS(read->date, entry.date);
+			TS_ASSERT_EQUALS(read->time, entry.time);
+			TS_ASSERT_EQUALS(read->playtime, entry.playtime);
+			TS_ASSERT_EQUALS(read->description, description);
+			TS_ASSERT(read->isAutosave);
+			TS_ASSERT(read->thumbnail);
+			if (read->thumbnail) {
+				TS_ASSERT_EQUALS(read->thumbnail->w, 4);
+				TS_ASSERT_EQUALS(read->thumbnail->h, 3);
+				TS_ASSERT(read->thumbnail->format == thumbnail->format);
+				for (int y = 0; y < thumbnail->h; y++)
+					TS_ASSERT_SAME_DATA(read->thumbnail->getBasePtr(0, y), thumbnail->getBasePtr(0, y), thumbnail->w * 2);
+			}
+		}
+
+		read = reader.find("roundtrip", "roundtrip.002", 42, 43);
+		TS_ASSERT(read);
+		if (read) {
+			TS_ASSERT(!read->valid);
+			TS_ASSERT(!read->thumbnail);
+		}
+
+		reader.release();
+	}
+
+	void test_stale_entries() {
+		clearIndex("stale");
+
+		SaveMetaIndex writer(_directory);
+		writer.set("stale", "stale.001", makeEntry(100, 5, "Save"));
+		writer.release();
+
+		SaveMetaIndex reader(_directory);
+		TS_ASSERT(!reader.find("stale", "stale.001", 101, 5));
+		TS_ASSERT(!reader.find("stale", "stale.001", 100, 6));
+		TS_ASSERT(reader.find("stale", "stale.001", 100, 5));
+		TS_ASSERT(!reader.find("stale", "stale.002", 100, 5));
+		reader.release();
+	}
+
+	void test_invalidate() {
+		clearIndex("invalidate");
+
+		SaveMetaIndex index(_directory);
+		index.set("invalidate", "invalidate.001", makeEntry(100, 5, "First"));
+		index.set("invalidate", "invalidate.002", makeEntry(100, 5, "Second"));
+
+		// Dropped from the loaded entries
+		index.invalidate("invalidate.001");
+		TS_ASSERT(!index.find("invalidate", "invalidate.001", 100, 5));
+		index.release();
+
+		// Skipped when the index is loaded again later
+		index.invalidate("invalidate.002");
+		TS_ASSERT(!index.find("invalidate", "invalidate.002", 100, 5));
+		index.release();
+
+		SaveMetaIndex reader(_directory);
+		TS_ASSERT(!reader.find("invalidate", "invalidate.001", 100, 5));
+		TS_ASSERT(!reader.find("invalidate", "invalidate.002", 100, 5));
+		reader.release();
+
+		// Recording the save again makes it usable
+		index.set("invalidate", "invalidate.002", makeEntry(200, 6, "Rewritten"));
+		const SaveMetaIndex::Entry *read = index.find("invalidate", "invalidate.002", 200, 6);
+		TS_ASSERT(read);
+		if (read)
+			TS_ASSERT_EQUALS(read->description, "Rewritten");
+		index.release();
+	}
+
+	void test_prune() {
+		clearIndex("prune");
+
+		SaveMetaIndex index(_directory);
+		index.set("prune", "prune.001", makeEntry(100, 5, "Kept"));
+		index.set("prune", "prune.002", makeEntry(100, 5, "Deleted"));
+
+		Common::StringArray filenames;
+		filenames.push_back("PRUNE.001");
+		index.prune("prune", filenames);
+
+		TS_ASSERT(index.find("prune", "prune.001", 100, 5));
+		TS_ASSERT(!index.find("prune", "prune.002", 100, 5));
+		index.release();
+
+		SaveMetaIndex reader(_directory);
+		TS_ASSERT(reader.find("prune", "prune.001", 100, 5));
+		TS_ASSERT(!reader.find("prune", "prune.002", 100, 5));
+		reader.release();
+	}
+};
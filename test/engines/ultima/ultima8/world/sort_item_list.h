@@ -0,0 +1,152 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/ultima/ultima8/world/sort_item.h"
+#include "engines/ultima/ultima8/world/sort_item_list.h"
+
+/**
+ * Test suite for the functions in engines/ultima/ultima8/world/sort_item_list.h
+ */
+class U8SortItemListTestSuite : public CxxTest::TestSuite {
+	struct TestItem {
+		uint16 itemNum;
+		Ultima::Ultima8::Box box;
+		bool occl;
+		bool roof;
+	};
+
+	uint32 _seed;
+
+	uint32 nextRandom(uint32 max) {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) % max;
+	}
+
+	TestItem randomItem(uint16 itemNum) {
+		static const int32 sizes[] = { 32, 64, 128 };
+		static const int32 heights[] = { 0, 8, 16, 40 };
+
+		TestItem item;
+		item.itemNum = itemNum;
+		item.box = Ultima::Ultima8::Box(nextRandom(16) * 32, nextRandom(16) * 32, heights[nextRandom(4)],
+				sizes[nextRandom(3)], sizes[nextRandom(3)], heights[nextRandom(4)]);
+		item.occl = nextRandom(3) == 0;
+		item.roof = nextRandom(8) == 0;
+		return item;
+	}
+
+	void addItems(Ultima::Ultima8::SortItemList &list, const Common::Array<TestItem> &items) {
+		list.begin();
+		for (uint i = 0; i < items.size(); i++) {
+			Ultima::Ultima8::SortItem *si = list.getUnused();
+			si->_itemNum = items[i].itemNum;
+			si->_shape = nullptr;
+			si->_shapeNum = items[i].itemNum;
+			si->_frame = 0;
+			si->_flags = 0;
+			si->_extFlags = 0;
+			si->setBoxBounds(items[i].box, 0, 0);
+			si->_occl = items[i].occl;
+			si->_solid = true;
+			si->_draw = true;
+			si->_roof = items[i].roof;
+			si->_noisy = false;
+			si->_anim = false;
+			si->_trans = false;
+			si->_fixed = false;
+			si->_land = false;
+			si->_sprite = false;
+			si->_invitem = false;
+			list.add(si);
+		}
+		list.end();
+	}
+
+	void checkSameLists(const Ultima::Ultima8::SortItemList &list1, const Ultima::Ultima8::SortItemList &list2) {
+		const Ultima::Ultima8::SortItem *si1 = list1.getItems();
+		const Ultima::Ultima8::SortItem *si2 = list2.getItems();
+		while (si1 && si2) {
+			TS_ASSERT_EQUALS(si1->_itemNum, si2->_itemNum);
+			TS_ASSERT_EQUALS(si1->_occluded, si2->_occluded);
+
+			Ultima::Ultima8::SortItem::DependsList::iterator d1 = si1->_depends.begin();
+			Ultima::Ultima8::SortItem::DependsList::iterator d2 = si2->_depends.begin();
+			while (d1 != si1->_depends.end() && d2 != si2->_depends.end()) {
+				TS_ASSERT_EQUALS((*d1)->_itemNum, (*d2)->_itemNum);
+				++d1;
+				++d2;
+			}
+			TS_ASSERT(!(d1 != si1->_depends.end()));
+			TS_ASSERT(!(d2 != si2->_depends.end()));
+
+			si1 = si1->_next;
+			si2 = si2->_next;
+		}
+		TS_ASSERT(!si1);
+		TS_ASSERT(!si2);
+	}
+
+public:
+	U8SortItemListTestSuite() : _seed(1) {
+	}
+
+	/* Unchanged frames keep all the items of the previous frame */
+	void test_reuse_unchanged() {
+		Common::Array<TestItem> items;
+		for (uint16 i = 1; i <= 40; i++)
+			items.push_back(randomItem(i));
+
+		Ultima::Ultima8::SortItemList list(16);
+		addItems(list, items);
+
+		Common::Array<const Ultima::Ultima8::SortItem *> before;
+		for (const Ultima::Ultima8::SortItem *si = list.getItems(); si; si = si->_next)
+			before.push_back(si);
+
+		addItems(list, items);
+
+		uint i = 0;
+		for (const Ultima::Ultima8::SortItem *si = list.getItems(); si; si = si->_next, i++) {
+			TS_ASSERT(i < before.size() && si == before[i]);
+		}
+		TS_ASSERT_EQUALS(i, before.size());
+	}
+
+	/* Lists kept between frames match lists built from scratch */
+	void test_frame_diff() {
+		Common::Array<TestItem> items;
+		uint16 nextItemNum = 1;
+		for (int i = 0; i < 60; i++)
+			items.push_back(randomItem(nextItemNum++));
+
+		Ultima::Ultima8::SortItemList kept(16);
+		for (int frame = 0; frame < 100; frame++) {
+			switch (nextRandom(4)) {
+			case 0: {
+				// Move an item
+				TestItem &item = items[nextRandom(items.size())];
+				item.box._x += 32;
+				item.box._z = 8 * nextRandom(4);
+				break;
+			}
+			case 1:
+				// Remove an item
+				if (items.size() > 1)
+					items.remove_at(nextRandom(items.size()));
+				break;
+			case 2:
+				// Add an item
+				items.insert_at(nextRandom(items.size() + 1), randomItem(nextItemNum++));
+				break;
+			default:
+				// Nothing changed
+				break;
+			}
+
+			addItems(kept, items);
+
+			Ultima::Ultima8::SortItemList rebuilt(16);
+			addItems(rebuilt, items);
+
+			checkSameLists(kept, rebuilt);
+		}
+	}
+};
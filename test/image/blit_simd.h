@@ -0,0 +1,236 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "graphics/blit.h"
+
+#include "../instrset_detect.h"
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class BlitSIMDTestSuite : public CxxTest::TestSuite {
+	typedef Graphics::BlendBlit::FillFunc FillFunc;
+
+	enum {
+		// Not a multiple of the SIMD widths, so that the tails are covered
+		kWidth = 37,
+		kHeight = 5
+	};
+
+	struct Kernel {
+		const char *name;
+		Graphics::FastBlitFunc func;
+		Graphics::PixelFormat srcFmt, dstFmt;
+	};
+
+	static Graphics::PixelFormat formatRGB565()   { return Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0); }
+	static Graphics::PixelFormat formatXRGB8888() { return Graphics::PixelFormat(4, 8, 8, 8, 0, 16,  8,  0,  0); }
+	static Graphics::PixelFormat formatARGB8888() { return Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24); }
+	static Graphics::PixelFormat formatABGR8888() { return Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24); }
+	static Graphics::PixelFormat formatRGBA8888() { return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0); }
+	static Graphics::PixelFormat formatBGRA8888() { return Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0); }
+
+	static void fillRandom(byte *buf, uint size, uint32 seed) {
+		for (uint i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			buf[i] = seed >> 16;
+		}
+	}
+
+	static uint32 readPixel(const byte *ptr, uint bpp) {
+		return bpp == 2 ? *(const uint16 *)ptr : *(const uint32 *)ptr;
+	}
+
+	// Converts pixel by pixel, like crossBlit does without a fast path
+	static void convertGeneric(const Kernel &kernel, byte *dst, const byte *src, uint w, uint h) {
+		const uint srcBpp = kernel.srcFmt.bytesPerPixel, dstBpp = kernel.dstFmt.bytesPerPixel;
+		for (uint i = 0; i < w * h; i++) {
+			uint8 a, r, g, b;
+			kernel.srcFmt.colorToARGB(readPixel(src + i * srcBpp, srcBpp), a, r, g, b);
+			const uint32 col = kernel.dstFmt.ARGBToColor(a, r, g, b);
+			if (dstBpp == 2)
+				*(uint16 *)(dst + i * dstBpp) = col;
+			else
+				*(uint32 *)(dst + i * dstBpp) = col;
+		}
+	}
+
+	static bool checkConversion(const Kernel &kernel) {
+		const uint srcBpp = kernel.srcFmt.bytesPerPixel, dstBpp = kernel.dstFmt.bytesPerPixel;
+		const uint srcPitch = kWidth * srcBpp + 6, dstPitch = kWidth * dstBpp + 10;
+		byte src[(kWidth * 4 + 6) * kHeight], dst[(kWidth * 4 + 10) * kHeight];
+		fillRandom(src, sizeof(src), 0x1234);
+		fillRandom(dst, sizeof(dst), 0x4321);
+
+		kernel.func(dst, src, dstPitch, srcPitch, kWidth, kHeight);
+
+		for (uint y = 0; y < kHeight; y++) {
+			for (uint x = 0; x < kWidth; x++) {
+				uint8 a, r, g, b;
+				kernel.srcFmt.colorToARGB(readPixel(src + y * srcPitch + x * srcBpp, srcBpp), a, r, g, b);
+				if (readPixel(dst + y * dstPitch + x * dstBpp, dstBpp) != kernel.dstFmt.ARGBToColor(a, r, g, b))
+					return false;
+			}
+		}
+
+		// Converting in place, as Surface::convertToInPlace does
+		byte buffer[kWidth * 4 * kHeight];
+		fillRandom(buffer, kWidth * srcBpp * kHeight, 0x1234);
+		memcpy(src, buffer, kWidth * srcBpp * kHeight);
+		kernel.func(buffer, buffer, kWidth * dstBpp, kWidth * srcBpp, kWidth, kHeight);
+
+		for (uint i = 0; i < kWidth * kHeight; i++) {
+			uint8 a, r, g, b;
+			kernel.srcFmt.colorToARGB(readPixel(src + i * srcBpp, srcBpp), a, r, g, b);
+			if (readPixel(buffer + i * dstBpp, dstBpp) != kernel.dstFmt.ARGBToColor(a, r, g, b))
+				return false;
+		}
+
+		return true;
+	}
+
+	static Common::Array<Kernel> getKernels() {
+		Common::Array<Kernel> kernels;
+
+#define ADD_KERNELS(prefix) \
+		{ \
+			const Kernel k[] = { \
+				{ #prefix "_swap<true, 0>",  prefix##_swap<true,   0>, formatABGR8888(), formatRGBA8888() }, \
+				{ #prefix "_swap<false, 8>", prefix##_swap<false,  8>, formatRGBA8888(), formatARGB8888() }, \
+				{ #prefix "_swap<false, 24>", prefix##_swap<false, 24>, formatABGR8888(), formatBGRA8888() }, \
+				{ #prefix "_swap<true, 8>",  prefix##_swap<true,   8>, formatARGB8888(), formatABGR8888() }, \
+				{ #prefix "_swap<true, 24>", prefix##_swap<true,  24>, formatRGBA8888(), formatBGRA8888() }, \
+				{ #prefix "_RGB565_XRGB8888", prefix##_RGB565_XRGB8888, formatRGB565(), formatXRGB8888() }, \
+				{ #prefix "_RGB565_ARGB8888", prefix##_RGB565_ARGB8888, formatRGB565(), formatARGB8888() }, \
+				{ #prefix "_XRGB8888_RGB565", prefix##_XRGB8888_RGB565, formatXRGB8888(), formatRGB565() }, \
+				{ #prefix "_XRGB8888_RGB565", prefix##_XRGB8888_RGB565, formatARGB8888(), formatRGB565() } \
+			}; \
+			for (int i = 0; i < ARRAYSIZE(k); i++) \
+				kernels.push_back(k[i]); \
+		}
+
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			ADD_KERNELS(Graphics::fastBlitSSE2)
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			ADD_KERNELS(Graphics::fastBlitAVX2)
+#endif
+#undef ADD_KERNELS
+
+		return kernels;
+	}
+
+	struct FillKernel {
+		const char *name;
+		FillFunc func;
+	};
+
+	static Common::Array<FillKernel> getFillKernels() {
+		Common::Array<FillKernel> kernels;
+#ifdef SCUMMVM_SSE2
+		const FillKernel sse2 = { "fillSSE2", Graphics::BlendBlit::fillSSE2 };
+		if (instrset_detect() >= 2)
+			kernels.push_back(sse2);
+#endif
+#ifdef SCUMMVM_AVX2
+		const FillKernel avx2 = { "fillAVX2", Graphics::BlendBlit::fillAVX2 };
+		if (instrset_detect() >= 8)
+			kernels.push_back(avx2);
+#endif
+		return kernels;
+	}
+
+	static void fill(FillFunc func, byte *dst, uint pitch, uint w, uint h, uint32 color, Graphics::TSpriteBlendMode blendMode) {
+		Graphics::BlendBlit::Args args(dst, nullptr, pitch, 0, 0, 0, w, h, 0, 0, 0, 0, color, 0);
+		func(args, blendMode);
+	}
+
+public:
+	void test_fast_blit_kernels() {
+		Common::Array<Kernel> kernels = getKernels();
+		for (uint i = 0; i < kernels.size(); i++)
+			TSM_ASSERT(kernels[i].name, checkConversion(kernels[i]));
+	}
+
+	void test_fill_kernels() {
+		const Graphics::TSpriteBlendMode blendModes[] = { Graphics::BLEND_NORMAL, Graphics::BLEND_ADDITIVE, Graphics::BLEND_SUBTRACTIVE, Graphics::BLEND_MULTIPLY };
+		// Colors are RGBA, with and without the color and alpha modulation
+		const uint32 colors[] = { 0xffffffff, 0xffffff80, 0xffffff00, 0x4080c0ff, 0x4080c07f, 0x12345601, 0x00000000, 0xfe01fffe };
+		const uint pitch = kWidth * 4 + 12;
+
+		Common::Array<FillKernel> kernels = getFillKernels();
+		for (uint f = 0; f < kernels.size(); f++) {
+			for (int m = 0; m < ARRAYSIZE(blendModes); m++) {
+				for (int c = 0; c < ARRAYSIZE(colors); c++) {
+					byte expected[pitch * kHeight], actual[pitch * kHeight];
+					fillRandom(expected, sizeof(expected), c * 17 + m);
+					memcpy(actual, expected, sizeof(actual));
+
+					fill(Graphics::BlendBlit::fillGeneric, expected, pitch, kWidth, kHeight, colors[c], blendModes[m]);
+					fill(kernels[f].func, actual, pitch, kWidth, kHeight, colors[c], blendModes[m]);
+					TSM_ASSERT_EQUALS(kernels[f].name, memcmp(expected, actual, sizeof(actual)), 0);
+				}
+			}
+		}
+	}
+
+	void test_benchmark() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		const uint w = 640, h = 480;
+#ifdef SLOW_TESTS
+		const int iters = 500;
+#else
+		const int iters = 5;
+#endif
+		byte *src = new byte[w * h * 4];
+		byte *dst = new byte[w * h * 4];
+		fillRandom(src, w * h * 4, 0x1234);
+
+		Common::Array<Kernel> kernels = getKernels();
+		for (uint i = 0; i < kernels.size(); i++) {
+			const Kernel &kernel = kernels[i];
+
+			uint32 start = g_system->getMillis();
+			for (int j = 0; j < iters; j++)
+				kernel.func(dst, src, w * kernel.dstFmt.bytesPerPixel, w * kernel.srcFmt.bytesPerPixel, w, h);
+			uint32 simdTime = g_system->getMillis() - start;
+
+			start = g_system->getMillis();
+			for (int j = 0; j < iters; j++)
+				convertGeneric(kernel, dst, src, w, h);
+			uint32 genericTime = g_system->getMillis() - start;
+
+			debug("%s: %u ms, generic: %u ms per %d iterations of %ux%u pixels", kernel.name, simdTime, genericTime, iters, w, h);
+		}
+
+		const Graphics::TSpriteBlendMode blendModes[] = { Graphics::BLEND_NORMAL, Graphics::BLEND_ADDITIVE, Graphics::BLEND_SUBTRACTIVE, Graphics::BLEND_MULTIPLY };
+		const char *blendNames[] = { "normal", "additive", "subtractive", "multiply" };
+		Common::Array<FillKernel> fillKernels = getFillKernels();
+		const FillKernel generic = { "fillGeneric", Graphics::BlendBlit::fillGeneric };
+		fillKernels.insert_at(0, generic);
+		for (uint f = 0; f < fillKernels.size(); f++) {
+			for (int m = 0; m < ARRAYSIZE(blendModes); m++) {
+				uint32 start = g_system->getMillis();
+				for (int j = 0; j < iters; j++)
+					fill(fillKernels[f].func, dst, w * 4, w, h, 0x4080c07f, blendModes[m]);
+				uint32 time = g_system->getMillis() - start;
+
+				debug("%s (%s): %u ms per %d iterations of %ux%u pixels", fillKernels[f].name, blendNames[m], time, iters, w, h);
+			}
+		}
+
+		delete[] src;
+		delete[] dst;
+#endif
+	}
+};
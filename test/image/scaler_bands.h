@@ -0,0 +1,174 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scalerplugin.h"
+#ifdef USE_EDGE_SCALERS
+#include "common/ptr.h"
+#include "graphics/scaler/edge.h"
+#endif
+
+/**
+ * Nearest neighbour 2x scaler that, like the Edge scaler, only redraws the
+ * pixels whose 3x3 neighbourhood changed since the last frame and copies
+ * everything else from the old output.
+ */
+class TestSourceScaler : public SourceScaler {
+public:
+	TestSourceScaler(const Graphics::PixelFormat &format) : SourceScaler(format) { _factor = 2; }
+
+	uint increaseFactor() override { return _factor; }
+	uint decreaseFactor() override { return _factor; }
+
+protected:
+	void internScale(const uint8 *srcPtr, uint32 srcPitch,
+	                 uint8 *dstPtr, uint32 dstPitch,
+	                 const uint8 *oldSrcPtr, uint32 oldSrcPitch,
+	                 int width, int height, const uint8 *buffer, uint32 bufferPitch) override {
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				bool changed = (oldSrcPtr == NULL);
+				for (int dy = -1; dy <= 1 && !changed; dy++) {
+					for (int dx = -1; dx <= 1; dx++) {
+						if (srcPtr[(y + dy) * (int)srcPitch + x + dx] != oldSrcPtr[(y + dy) * (int)oldSrcPitch + x + dx])
+							changed = true;
+					}
+				}
+
+				for (int i = 0; i < 2; i++) {
+					for (int j = 0; j < 2; j++) {
+						uint8 *dst = dstPtr + (y * 2 + i) * dstPitch + x * 2 + j;
+						if (changed)
+							*dst = srcPtr[y * srcPitch + x] + i * 2 + j;
+						else
+							*dst = buffer[(y * 2 + i) * bufferPitch + x * 2 + j];
+					}
+				}
+			}
+		}
+	}
+};
+
+class ScalerBandsTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 24,
+		kHeight = 20,
+		kPadding = 1,
+		kSrcPitch = kWidth + kPadding * 2,
+		kDstPitch = kWidth * 2
+	};
+
+	static void scaleFrames(int bandHeight, byte *output) {
+		TestSourceScaler scaler(Graphics::PixelFormat::createFormatCLUT8());
+		scaler.setBandHeight(bandHeight);
+
+		byte src[kSrcPitch * (kHeight + kPadding * 2)];
+		memset(src, 0, sizeof(src));
+		byte *srcOrigin = src + kPadding * kSrcPitch + kPadding;
+
+		scaler.setSource(src, kSrcPitch, kWidth, kHeight, kPadding);
+		scaler.enableSource(true);
+
+		for (int frame = 0; frame < 4; frame++) {
+			// Change a few scattered pixels, including some on band edges
+			for (int i = 0; i < 12; i++) {
+				int x = (i * 7 + frame * 5) % kWidth;
+				int y = (i * 5 + frame * 3) % kHeight;
+				srcOrigin[y * kSrcPitch + x] += 16 + frame;
+			}
+
+			// Scale a sub rect, then the whole screen
+			const int rx = 3, ry = 2, rw = 17, rh = 15;
+			scaler.scale(srcOrigin + ry * kSrcPitch + rx, kSrcPitch,
+			             output + ry * 2 * kDstPitch + rx * 2, kDstPitch, rw, rh, rx, ry);
+			scaler.scale(srcOrigin, kSrcPitch, output, kDstPitch, kWidth, kHeight, 0, 0);
+			output += kDstPitch * kHeight * 2;
+		}
+	}
+
+#ifdef USE_EDGE_SCALERS
+	enum {
+		kEdgeWidth = 40,
+		kEdgeHeight = 30,
+		kEdgeSrcPitch = kEdgeWidth + kPadding * 2,
+		kEdgeFrames = 3
+	};
+
+	// Scales a few frames of a 16 bit picture. The background only has
+	// vertical stripes, so rows compared against the wrong part of the old
+	// source would look unchanged.
+	static void scaleEdgeFrames(uint factor, int bandHeight, uint16 *output) {
+		// The scaler keeps large tables, so it doesn't go on the stack
+		Common::ScopedPtr<EdgeScaler> scaler(new EdgeScaler(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0)));
+		if (factor == 3)
+			scaler->increaseFactor();
+		scaler->setBandHeight(bandHeight);
+
+		uint16 src[kEdgeSrcPitch * (kEdgeHeight + kPadding * 2)];
+		memset(src, 0, sizeof(src));
+		uint16 *srcOrigin = src + kPadding * kEdgeSrcPitch + kPadding;
+
+		const uint dstPitch = kEdgeWidth * factor;
+		const uint frameSize = dstPitch * kEdgeHeight * factor;
+
+		scaler->setSource((const byte *)src, kEdgeSrcPitch * 2, kEdgeWidth, kEdgeHeight, kPadding);
+		scaler->enableSource(true);
+
+		for (int frame = 0; frame < kEdgeFrames; frame++) {
+			// Move a small shape down the picture, so that it lands on rows
+			// which other bands would compare against the old position
+			for (int y = 0; y < kEdgeHeight; y++) {
+				for (int x = 0; x < kEdgeWidth; x++) {
+					const int sy = y - 2 - frame * 10;
+					const bool shape = sy >= 0 && sy < 6 && x >= 5 && x < 11 - sy / 2;
+					srcOrigin[y * kEdgeSrcPitch + x] = shape ? 0xF800 : (((x / 3) & 1) ? 0x07E0 : 0x001F);
+				}
+			}
+
+			scaler->scale((const uint8 *)srcOrigin, kEdgeSrcPitch * 2, (uint8 *)output, dstPitch * 2,
+			              kEdgeWidth, kEdgeHeight, 0, 0);
+			output += frameSize;
+		}
+	}
+
+	void checkEdgeBands(uint factor) {
+		const uint size = kEdgeWidth * factor * kEdgeHeight * factor * kEdgeFrames;
+		uint16 *expected = new uint16[size];
+		uint16 *actual = new uint16[size];
+
+		scaleEdgeFrames(factor, kEdgeHeight, expected);
+		static const int bandHeights[] = { 1, 2, 3, 7, 0 };
+		for (uint i = 0; i < ARRAYSIZE(bandHeights); i++) {
+			memset(actual, 0, size * sizeof(uint16));
+			scaleEdgeFrames(factor, bandHeights[i], actual);
+			TS_ASSERT_EQUALS(memcmp(expected, actual, size * sizeof(uint16)), 0);
+		}
+
+		delete[] expected;
+		delete[] actual;
+	}
+#endif
+
+public:
+	void test_bands_match_single_pass() {
+		static byte expected[kDstPitch * kHeight * 2 * 4];
+		static byte actual[kDstPitch * kHeight * 2 * 4];
+
+		scaleFrames(kHeight, expected);
+		for (int bandHeight = 1; bandHeight < 6; bandHeight++) {
+			memset(actual, 0, sizeof(actual));
+			scaleFrames(bandHeight, actual);
+			TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(actual)), 0);
+		}
+
+		// The automatic band height gives the same result as well
+		memset(actual, 0, sizeof(actual));
+		scaleFrames(0, actual);
+		TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(actual)), 0);
+	}
+
+#ifdef USE_EDGE_SCALERS
+	void test_edge_bands_match_single_pass() {
+		checkEdgeBands(2);
+		checkEdgeBands(3);
+	}
+#endif
+};
@@ -0,0 +1,96 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/scummsys.h"
+
+#ifdef USE_TINYGL
+#include "graphics/tinygl/zspan.h"
+
+#include "../instrset_detect.h"
+#endif
+
+class TinyGLDepthSpanTestSuite : public CxxTest::TestSuite {
+#ifdef USE_TINYGL
+	typedef uint32 (*TestFunc)(const uint *, uint, int, uint, int);
+	typedef void (*WriteFunc)(uint *, uint, int, uint, int);
+
+	enum {
+		kSpanSize = 75
+	};
+
+	uint _zbuf[kSpanSize];
+
+	void fillDepth(uint z, int dzdx) {
+		uint32 seed = 0x4321;
+		for (int i = 0; i < kSpanSize; i++) {
+			seed = seed * 1103515245 + 12345;
+			// Mix values close to the span with random ones, which also
+			// covers the unsigned range above 0x80000000
+			if (seed & 0x10000)
+				_zbuf[i] = z + i * dzdx + (int)((seed >> 20) & 3) - 1;
+			else
+				_zbuf[i] = seed;
+		}
+	}
+
+	void compareFuncs(TestFunc test, WriteFunc write) {
+		static const int funcs[] = { TGL_NEVER, TGL_LESS, TGL_EQUAL, TGL_LEQUAL, TGL_GREATER, TGL_NOTEQUAL, TGL_GEQUAL, TGL_ALWAYS };
+		static const uint starts[] = { 0x00001000, 0x7ffffff0, 0xfffffff8 };
+		static const int steps[] = { 0, 1, -3, 0x12345 };
+
+		for (int f = 0; f < ARRAYSIZE(funcs); f++) {
+			for (int i = 0; i < ARRAYSIZE(starts); i++) {
+				for (int j = 0; j < ARRAYSIZE(steps); j++) {
+					for (uint count = 0; count <= TinyGL::DepthSpan::kMaxTestCount; count++) {
+						fillDepth(starts[i], steps[j]);
+						TS_ASSERT_EQUALS(test(_zbuf + 1, starts[i], steps[j], count, funcs[f]),
+						                 TinyGL::DepthSpan::testGeneric(_zbuf + 1, starts[i], steps[j], count, funcs[f]));
+					}
+
+					uint expected[kSpanSize];
+					fillDepth(starts[i], steps[j]);
+					TinyGL::DepthSpan::writeGeneric(_zbuf + 1, starts[i], steps[j], kSpanSize - 2, funcs[f]);
+					memcpy(expected, _zbuf, sizeof(expected));
+
+					fillDepth(starts[i], steps[j]);
+					write(_zbuf + 1, starts[i], steps[j], kSpanSize - 2, funcs[f]);
+					TS_ASSERT_EQUALS(memcmp(expected, _zbuf, sizeof(expected)), 0);
+				}
+			}
+		}
+	}
+#endif
+
+public:
+	void test_generic() {
+#ifdef USE_TINYGL
+		uint zbuf[4] = { 10, 20, 30, 40 };
+
+		// Depth values are 15, 20, 25 and 30
+		TS_ASSERT_EQUALS(TinyGL::DepthSpan::testGeneric(zbuf, 15, 5, 4, TGL_LESS), 0x1u);
+		TS_ASSERT_EQUALS(TinyGL::DepthSpan::testGeneric(zbuf, 15, 5, 4, TGL_LEQUAL), 0x3u);
+		TS_ASSERT_EQUALS(TinyGL::DepthSpan::testGeneric(zbuf, 15, 5, 4, TGL_EQUAL), 0x2u);
+		TS_ASSERT_EQUALS(TinyGL::DepthSpan::testGeneric(zbuf, 15, 5, 4, TGL_GEQUAL), 0xeu);
+		TS_ASSERT_EQUALS(TinyGL::DepthSpan::test(zbuf, 15, 5, 4, TGL_NEVER), 0u);
+		TS_ASSERT_EQUALS(TinyGL::DepthSpan::test(zbuf, 15, 5, 4, TGL_ALWAYS), 0xfu);
+
+		TinyGL::DepthSpan::writeGeneric(zbuf, 15, 5, 4, TGL_GREATER);
+		TS_ASSERT_EQUALS(zbuf[0], 10u);
+		TS_ASSERT_EQUALS(zbuf[1], 20u);
+		TS_ASSERT_EQUALS(zbuf[2], 25u);
+		TS_ASSERT_EQUALS(zbuf[3], 30u);
+#endif
+	}
+
+	void test_simd() {
+#ifdef USE_TINYGL
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			compareFuncs(TinyGL::DepthSpan::testSSE2, TinyGL::DepthSpan::writeSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			compareFuncs(TinyGL::DepthSpan::testAVX2, TinyGL::DepthSpan::writeAVX2);
+#endif
+#endif
+	}
+};
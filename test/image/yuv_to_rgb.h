@@ -0,0 +1,115 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+#include "../instrset_detect.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	typedef Graphics::YUVToRGBManager::ConvertRowFunc ConvertRowFunc;
+
+	enum {
+		// Not a multiple of the SIMD widths, so that the tails are covered
+		kWidth = 70,
+		kHeight = 6,
+		kPitch = 80
+	};
+
+	byte _y[kPitch * kHeight];
+	byte _u[kPitch * kHeight];
+	byte _v[kPitch * kHeight];
+	byte _a[kPitch * kHeight];
+
+	void fillPlanes() {
+		uint32 seed = 0x1234;
+		for (int i = 0; i < kPitch * kHeight; i++) {
+			seed = seed * 1103515245 + 12345;
+			_y[i] = seed >> 8;
+			_u[i] = seed >> 16;
+			_v[i] = seed >> 24;
+			_a[i] = (seed >> 4) ^ i;
+		}
+		// Make sure that the extremes are used as well
+		_y[0] = 0; _u[0] = 0; _v[0] = 0;
+		_y[1] = 255; _u[1] = 255; _v[1] = 255;
+		_y[2] = 0; _u[2] = 255; _v[2] = 0;
+		_y[3] = 255; _u[3] = 0; _v[3] = 255;
+	}
+
+	void convert(ConvertRowFunc func, Graphics::Surface &dst, Graphics::YUVToRGBManager::LuminanceScale scale, int mode) {
+		Graphics::YUVToRGBManager &manager = YUVToRGBMan;
+		manager._convertRowFunc = func;
+		manager._convertRowFuncInit = true;
+
+		memset(dst.getPixels(), 0, dst.pitch * dst.h);
+		switch (mode) {
+		case 0:
+			manager.convert444(&dst, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+			break;
+		case 1:
+			manager.convert422(&dst, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+			break;
+		case 2:
+			manager.convert420(&dst, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+			break;
+		default:
+			manager.convert420Alpha(&dst, scale, _y, _u, _v, _a, kWidth, kHeight, kPitch, kPitch);
+			break;
+		}
+	}
+
+	void compareWithTables(ConvertRowFunc func) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = {
+			Graphics::YUVToRGBManager::kScaleFull,
+			Graphics::YUVToRGBManager::kScaleITU
+		};
+
+		Graphics::YUVToRGBManager &manager = YUVToRGBMan;
+		ConvertRowFunc oldFunc = manager._convertRowFunc;
+		bool oldInit = manager._convertRowFuncInit;
+
+		fillPlanes();
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			Graphics::Surface expected, actual;
+			expected.create(kWidth, kHeight, formats[f]);
+			actual.create(kWidth, kHeight, formats[f]);
+
+			for (int s = 0; s < ARRAYSIZE(scales); s++) {
+				for (int mode = 0; mode < 4; mode++) {
+					convert(0, expected, scales[s], mode);
+					convert(func, actual, scales[s], mode);
+					TS_ASSERT_EQUALS(memcmp(expected.getPixels(), actual.getPixels(), expected.pitch * expected.h), 0);
+				}
+			}
+
+			expected.free();
+			actual.free();
+		}
+
+		manager._convertRowFunc = oldFunc;
+		manager._convertRowFuncInit = oldInit;
+	}
+
+public:
+	void test_convert_row_generic() {
+		compareWithTables(Graphics::YUVToRGBManager::convertRowGeneric);
+	}
+
+	void test_convert_row_simd() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			compareWithTables(Graphics::YUVToRGBManager::convertRowSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			compareWithTables(Graphics::YUVToRGBManager::convertRowAVX2);
+#endif
+	}
+};
@@ -0,0 +1,145 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+#include "../null_osystem.h"
+
+class DecodeAheadTestSuite : public CxxTest::TestSuite {
+	enum {
+		kFrameCount = 20
+	};
+
+	class TestDecoder : public Video::VideoDecoder {
+	public:
+		TestDecoder(uint decodeAhead) {
+			addTrack(new TestTrack());
+			setDecodeAhead(decodeAhead);
+		}
+		~TestDecoder() override { close(); }
+
+		bool loadStream(Common::SeekableReadStream *stream) override { return false; }
+
+		uint getQueuedFrames() const { return _decodedFrames.size(); }
+
+	private:
+		// Each frame is filled with its frame number
+		class TestTrack : public Video::VideoDecoder::FixedRateVideoTrack {
+		public:
+			TestTrack() : _curFrame(-1), _reversed(false) {
+				_surface.create(4, 4, Graphics::PixelFormat::createFormatCLUT8());
+			}
+			~TestTrack() override { _surface.free(); }
+
+			uint16 getWidth() const override { return _surface.w; }
+			uint16 getHeight() const override { return _surface.h; }
+			Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+			int getCurFrame() const override { return _curFrame; }
+			int getFrameCount() const override { return kFrameCount; }
+
+			bool endOfTrack() const override {
+				return _reversed ? _curFrame <= 0 : _curFrame >= kFrameCount - 1;
+			}
+
+			const Graphics::Surface *decodeNextFrame() override {
+				_curFrame += _reversed ? -1 : 1;
+				_surface.fillRect(Common::Rect(_surface.w, _surface.h), _curFrame);
+				return &_surface;
+			}
+
+			bool isSeekable() const override { return true; }
+			bool seek(const Audio::Timestamp &time) override {
+				_curFrame = getFrameAtTime(time) - 1;
+				return true;
+			}
+
+			bool setReverse(bool reverse) override {
+				_reversed = reverse;
+				return true;
+			}
+			bool isReversed() const override { return _reversed; }
+
+		protected:
+			Common::Rational getFrameRate() const override { return 10; }
+
+		private:
+			Graphics::Surface _surface;
+			int _curFrame;
+			bool _reversed;
+		};
+	};
+
+	static int nextFrame(Video::VideoDecoder &decoder) {
+		const Graphics::Surface *frame = decoder.decodeNextFrame();
+		return frame ? *(const byte *)frame->getPixels() : -1;
+	}
+
+	// Runs the same steps on a decoder with and without decode ahead
+	void checkSame(TestDecoder &decoder, TestDecoder &reference, uint frames) {
+		for (uint i = 0; i < frames; i++) {
+			TS_ASSERT_EQUALS(decoder.getCurFrame(), reference.getCurFrame());
+			TS_ASSERT_EQUALS(nextFrame(decoder), nextFrame(reference));
+			decoder.decodeAhead(1000);
+		}
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), reference.getCurFrame());
+	}
+
+public:
+	void test_queue_fills() {
+		Common::install_null_g_system();
+		TestDecoder decoder(3), reference(0);
+
+		checkSame(decoder, reference, 2);
+		TS_ASSERT_EQUALS(decoder.getQueuedFrames(), 3u);
+		TS_ASSERT_EQUALS(reference.getQueuedFrames(), 0u);
+		checkSame(decoder, reference, 8);
+	}
+
+	void test_seek_drops_queue() {
+		Common::install_null_g_system();
+		TestDecoder decoder(3), reference(0);
+
+		checkSame(decoder, reference, 4);
+		TS_ASSERT(decoder.getQueuedFrames() > 0);
+
+		TS_ASSERT(decoder.seekToFrame(12));
+		TS_ASSERT(reference.seekToFrame(12));
+		TS_ASSERT_EQUALS(decoder.getQueuedFrames(), 0u);
+		TS_ASSERT_EQUALS(nextFrame(decoder), 12);
+		TS_ASSERT_EQUALS(nextFrame(reference), 12);
+		checkSame(decoder, reference, 3);
+	}
+
+	void test_rewind_drops_queue() {
+		Common::install_null_g_system();
+		TestDecoder decoder(3), reference(0);
+
+		checkSame(decoder, reference, 5);
+		TS_ASSERT(decoder.getQueuedFrames() > 0);
+
+		TS_ASSERT(decoder.rewind());
+		TS_ASSERT(reference.rewind());
+		TS_ASSERT_EQUALS(decoder.getQueuedFrames(), 0u);
+		TS_ASSERT_EQUALS(nextFrame(decoder), 0);
+		TS_ASSERT_EQUALS(nextFrame(reference), 0);
+		checkSame(decoder, reference, 3);
+	}
+
+	void test_reverse_drops_queue() {
+		Common::install_null_g_system();
+		TestDecoder decoder(3), reference(0);
+
+		checkSame(decoder, reference, 6);
+		TS_ASSERT(decoder.getQueuedFrames() > 0);
+
+		TS_ASSERT(decoder.setReverse(true));
+		TS_ASSERT(reference.setReverse(true));
+		TS_ASSERT_EQUALS(decoder.getQueuedFrames(), 0u);
+		TS_ASSERT_EQUALS(nextFrame(decoder), 4);
+		TS_ASSERT_EQUALS(nextFrame(reference), 4);
+
+		// Nothing is decoded ahead while playing in reverse
+		checkSame(decoder, reference, 3);
+		TS_ASSERT_EQUALS(decoder.getQueuedFrames(), 0u);
+	}
+};
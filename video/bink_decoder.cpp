@@ -30,7 +30,6 @@
 #include "common/textconsole.h"
 #include "common/intrinsics.h"
 #include "common/stream.h"
-#include "common/substream.h"
 #include "common/file.h"
 #include "common/str.h"
 #include "common/bitstream.h"
@@ -188,8 +187,7 @@ void BinkDecoder::readNextPacket() {
 			//                  Number of samples in bytes
 			audio.sampleCount = _bink->readUint32LE() / (2 * audio.channels);
 
-			audio.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-					audioPacketStart + 4, audioPacketEnd), DisposeAfterUse::YES);
+			audio.bits = readPacket(audioPacketStart + 4, audioPacketEnd);
 
 			audioTrack->decodePacket();
 
@@ -205,8 +203,7 @@ void BinkDecoder::readNextPacket() {
 	uint32 videoPacketStart = _bink->pos();
 	uint32 videoPacketEnd   = _bink->pos() + frameSize;
 
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-			videoPacketStart, videoPacketEnd), DisposeAfterUse::YES);
+	frame.bits = readPacket(videoPacketStart, videoPacketEnd);
 
 	videoTrack->decodePacket(frame);
 
@@ -214,6 +211,24 @@ void BinkDecoder::readNextPacket() {
 	frame.bits = 0;
 }
 
+Common::BitStreamMemory32LELSB *BinkDecoder::readPacket(uint32 start, uint32 end) {
+	// The packet is read in one go, so that the bit reader works on memory
+	// instead of going through the file stream for every 32 bits
+	uint32 size = end - start;
+	if (_packetData.size() < size)
+		_packetData.resize(size);
+
+	if (!_bink->seek(start))
+		error("Bad bink seek");
+
+	// Like with reading past the end of the file, a truncated packet reads as zeros
+	uint32 bytesRead = _bink->read(_packetData.data(), size);
+	if (bytesRead < size)
+		memset(_packetData.data() + bytesRead, 0, size - bytesRead);
+
+	return new Common::BitStreamMemory32LELSB(new Common::BitStreamMemoryStream(_packetData.data(), size), DisposeAfterUse::YES);
+}
+
 VideoDecoder::AudioTrack *BinkDecoder::getAudioTrack(int index) {
 	// Bink audio track indexes are relative to the first audio track
 	Track *track = getTrack(index + 1);
@@ -721,7 +736,7 @@ void BinkDecoder::BinkVideoTrack::deinitBundles() {
 
 void BinkDecoder::BinkVideoTrack::initHuffman() {
 	for (int i = 0; i < 16; i++)
-		_huffman[i] = new Common::Huffman<Common::BitStream32LELSB>(binkHuffmanLengths[i][15], 16, binkHuffmanCodes[i], binkHuffmanLengths[i]);
+		_huffman[i] = new Common::Huffman<Common::BitStreamMemory32LELSB>(binkHuffmanLengths[i][15], 16, binkHuffmanCodes[i], binkHuffmanLengths[i]);
 }
 
 byte BinkDecoder::BinkVideoTrack::getHuffmanSymbol(VideoFrame &video, Huffman &huffman) {
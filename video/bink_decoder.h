@@ -106,7 +106,7 @@ private:
 
 		uint32 sampleCount;
 
-		Common::BitStream32LELSB *bits;
+		Common::BitStreamMemory32LELSB *bits;
 
 		bool first;
 
@@ -139,7 +139,7 @@ private:
 		uint32 offset;
 		uint32 size;
 
-		Common::BitStream32LELSB *bits;
+		Common::BitStreamMemory32LELSB *bits;
 
 		VideoFrame();
 		~VideoFrame();
@@ -266,7 +266,7 @@ private:
 
 		Bundle _bundles[kSourceMAX]; ///< Bundles for decoding all data types.
 
-		Common::Huffman<Common::BitStream32LELSB> *_huffman[16]; ///< The 16 Huffman codebooks used in Bink decoding.
+		Common::Huffman<Common::BitStreamMemory32LELSB> *_huffman[16]; ///< The 16 Huffman codebooks used in Bink decoding.
 
 		/** Huffman codebooks to use for decoding high nibbles in color data types. */
 		Huffman _colHighHuffman[16];
@@ -381,6 +381,10 @@ private:
 
 	Common::Array<AudioInfo> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
+	Common::Array<byte> _packetData;        ///< The audio or video packet being decoded.
+
+	/** Read a packet into memory and create a bit stream reading from it. */
+	Common::BitStreamMemory32LELSB *readPacket(uint32 start, uint32 end);
 
 	void initAudioTrack(AudioInfo &audio);
 };
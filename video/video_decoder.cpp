@@ -28,6 +28,8 @@
 #include "common/file.h"
 #include "common/system.h"
 
+#include "graphics/surface.h"
+
 namespace Video {
 
 VideoDecoder::VideoDecoder() {
@@ -48,12 +50,21 @@ VideoDecoder::VideoDecoder() {
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
 	_videoCodecAccuracy = Image::CodecAccuracy::Default;
+	_decodeAheadFrames = 0;
+	_decodeAheadCost = 0;
+	_presentedSurface = 0;
+}
+
+VideoDecoder::~VideoDecoder() {
+	freeDecodeAhead();
 }
 
 void VideoDecoder::close() {
 	if (isPlaying())
 		stop();
 
+	freeDecodeAhead();
+
 	for (auto *track : _tracks)
 		delete track;
 
@@ -114,9 +125,17 @@ bool VideoDecoder::needsUpdate() const {
 }
 
 void VideoDecoder::delayMillis(uint msecs) {
-	if (!needsUpdate())
-		g_system->delayMillis(MIN<uint>(msecs, getTimeToNextFrame()));
-	else
+	if (!needsUpdate()) {
+		uint32 delay = MIN<uint>(msecs, getTimeToNextFrame());
+
+		// Use the time until the next frame is due to decode ahead
+		uint32 startTime = g_system->getMillis();
+		decodeAhead(delay);
+		uint32 elapsed = g_system->getMillis() - startTime;
+
+		if (elapsed < delay)
+			g_system->delayMillis(delay - elapsed);
+	} else
 		g_system->delayMillis(1); /* This is needed to keep the mixer and timers active */
 }
 
@@ -212,6 +231,10 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	// Frames which were decoded ahead of time go first
+	if (!_decodedFrames.empty())
+		return presentDecodedFrame();
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -232,11 +255,33 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+void VideoDecoder::setDecodeAhead(uint frames) {
+	// Frames which are already queued are still returned
+	_decodeAheadFrames = frames;
+}
+
+void VideoDecoder::decodeAhead(uint32 maxMillis) {
+	uint32 startTime = g_system->getMillis();
+	VideoTrack *track;
+
+	// Stop once the next frame is not expected to be done in time
+	while ((track = getDecodeAheadTrack()) && g_system->getMillis() - startTime + _decodeAheadCost < maxMillis) {
+		uint32 frameStartTime = g_system->getMillis();
+		decodeAheadFrame(track);
+		_decodeAheadCost = g_system->getMillis() - frameStartTime;
+	}
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// Frames decoded ahead of time follow the current one, so the track
+	// has to go back to where they started
+	if (reverse && !_decodedFrames.empty() && !seekToFrame(getCurFrame() + 1))
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (auto &track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)track)->isReversed() != reverse) {
@@ -257,6 +302,10 @@ const byte *VideoDecoder::getPalette() {
 }
 
 int VideoDecoder::getCurFrame() const {
+	// Only videos with a single video track are decoded ahead
+	if (!_decodedFrames.empty())
+		return _decodedFrames.front().curFrame;
+
 	int32 frame = -1;
 
 	for (const auto &track : _tracks)
@@ -302,7 +351,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = _decodedFrames.empty() ? _nextVideoTrack->getNextFrameStartTime() : _decodedFrames.front().startTime;
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -321,6 +370,13 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 
 bool VideoDecoder::endOfVideo() const {
 	for (const auto &track : _tracks) {
+		// The video track is ahead of the frames which are still queued
+		if (!_decodedFrames.empty() && track == _nextVideoTrack) {
+			if (!isPlaying() || !_endTimeSet || _decodedFrames.front().startTime < (uint)_endTime.msecs())
+				return false;
+			continue;
+		}
+
 		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
 		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
@@ -345,6 +401,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	discardDecodedFrames();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -379,6 +437,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	discardDecodedFrames();
+
 	// Stop all tracks so they can be seek'ed
 	if (isPlaying())
 		stopAudio();
@@ -970,6 +1030,9 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 }
 
 bool VideoDecoder::endOfVideoTracks() const {
+	if (!_decodedFrames.empty())
+		return false;
+
 	for (const auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeVideo && !track->endOfTrack())
 			return false;
@@ -1038,6 +1101,13 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *videoTrack = (const VideoTrack *)track;
 
+		// The video track is ahead of the frames which are still queued
+		if (!_decodedFrames.empty() && videoTrack == _nextVideoTrack) {
+			if (!isPlaying() || !_endTimeSet || _decodedFrames.front().startTime < (uint)_endTime.msecs())
+				return true;
+			continue;
+		}
+
 		bool videoEndTimeReached = _endTimeSet && videoTrack->getNextFrameStartTime() >= (uint)_endTime.msecs();
 		bool endReached = videoTrack->endOfTrack() || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
@@ -1055,6 +1125,110 @@ bool VideoDecoder::hasAudio() const {
 	return false;
 }
 
+VideoDecoder::VideoTrack *VideoDecoder::getDecodeAheadTrack() const {
+	if ((uint)_decodedFrames.size() >= _decodeAheadFrames)
+		return 0;
+
+	VideoTrack *videoTrack = 0;
+
+	for (const auto &track : _tracks) {
+		if (track->getTrackType() == Track::kTrackTypeVideo) {
+			// The queue only keeps the state of a single track
+			if (videoTrack)
+				return 0;
+
+			videoTrack = (VideoTrack *)track;
+		}
+	}
+
+	if (!videoTrack || videoTrack != _nextVideoTrack || videoTrack->isReversed() || videoTrack->endOfTrack())
+		return 0;
+
+	if (_endTimeSet && videoTrack->getNextFrameStartTime() >= (uint)_endTime.msecs())
+		return 0;
+
+	return videoTrack;
+}
+
+void VideoDecoder::decodeAheadFrame(VideoTrack *track) {
+	DecodedFrame frame;
+	frame.curFrame = track->getCurFrame();
+	frame.startTime = track->getNextFrameStartTime();
+
+	_canSetDither = false;
+	_canSetDefaultFormat = false;
+
+	readNextPacket();
+	const Graphics::Surface *surface = track->decodeNextFrame();
+
+	frame.surface = 0;
+	if (surface) {
+		if (!_freeDecodeSurfaces.empty()) {
+			frame.surface = _freeDecodeSurfaces.back();
+			_freeDecodeSurfaces.pop_back();
+		} else {
+			frame.surface = new Graphics::Surface();
+		}
+
+		if (frame.surface->w != surface->w || frame.surface->h != surface->h || frame.surface->format != surface->format) {
+			frame.surface->free();
+			frame.surface->create(surface->w, surface->h, surface->format);
+		}
+		frame.surface->copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+	}
+
+	frame.dirtyPalette = track->hasDirtyPalette();
+	if (frame.dirtyPalette)
+		memcpy(frame.palette, track->getPalette(), sizeof(frame.palette));
+
+	_decodedFrames.push(frame);
+}
+
+const Graphics::Surface *VideoDecoder::presentDecodedFrame() {
+	// The surface returned last time is not in use anymore
+	if (_presentedSurface)
+		_freeDecodeSurfaces.push_back(_presentedSurface);
+
+	const DecodedFrame &frame = _decodedFrames.front();
+	_presentedSurface = frame.surface;
+
+	if (frame.dirtyPalette) {
+		memcpy(_presentedPalette, frame.palette, sizeof(_presentedPalette));
+		_palette = _presentedPalette;
+		_dirtyPalette = true;
+	}
+
+	_decodedFrames.pop();
+
+	// Once the queue is empty, the track state is the current one again
+	if (_decodedFrames.empty())
+		findNextVideoTrack();
+
+	return _presentedSurface;
+}
+
+void VideoDecoder::discardDecodedFrames() {
+	while (!_decodedFrames.empty()) {
+		if (_decodedFrames.front().surface)
+			_freeDecodeSurfaces.push_back(_decodedFrames.front().surface);
+		_decodedFrames.pop();
+	}
+}
+
+void VideoDecoder::freeDecodeAhead() {
+	discardDecodedFrames();
+
+	if (_presentedSurface)
+		_freeDecodeSurfaces.push_back(_presentedSurface);
+	_presentedSurface = 0;
+
+	for (auto *surface : _freeDecodeSurfaces) {
+		surface->free();
+		delete surface;
+	}
+	_freeDecodeSurfaces.clear();
+}
+
 void VideoDecoder::eraseTrack(Track *track) {
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
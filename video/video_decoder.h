@@ -26,6 +26,7 @@
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
 #include "common/path.h"
+#include "common/queue.h"
 #include "common/rational.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
@@ -53,7 +54,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -365,6 +366,32 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Set how many frames may be decoded ahead of time.
+	 *
+	 * Frames are decoded ahead while waiting for the next frame in
+	 * delayMillis() or decodeAhead(), and decodeNextFrame() returns them
+	 * from the queue once they are due, so a slow frame can be absorbed by
+	 * the idle time before the preceding ones.
+	 *
+	 * All getters of this class report the state of the last frame returned
+	 * by decodeNextFrame() while frames are queued. Tracks queried directly
+	 * through getTrack() are ahead of it by the number of queued frames.
+	 *
+	 * Decoding ahead only happens for videos with a single video track
+	 * played forward. Seeking and rewinding discard the queued frames.
+	 *
+	 * @param frames The maximum number of frames to queue, 0 to disable
+	 */
+	void setDecodeAhead(uint frames);
+
+	/**
+	 * Decode frames ahead of time, as long as the queue set up with
+	 * setDecodeAhead() is not full and the next frame is expected to
+	 * fit in the given time.
+	 */
+	void decodeAhead(uint32 maxMillis);
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -1028,6 +1055,28 @@ protected:
 
 	VideoTrack *_nextVideoTrack;
 
+	// Decode ahead queue
+	struct DecodedFrame {
+		Graphics::Surface *surface;
+		int curFrame;
+		uint32 startTime;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+	};
+
+	VideoTrack *getDecodeAheadTrack() const;
+	void decodeAheadFrame(VideoTrack *track);
+	const Graphics::Surface *presentDecodedFrame();
+	void discardDecodedFrames();
+	void freeDecodeAhead();
+
+	uint _decodeAheadFrames;
+	uint32 _decodeAheadCost;
+	Common::Queue<DecodedFrame> _decodedFrames;
+	Common::Array<Graphics::Surface *> _freeDecodeSurfaces;
+	Graphics::Surface *_presentedSurface;
+	byte _presentedPalette[256 * 3];
+
 	Image::CodecAccuracy _videoCodecAccuracy;
 
 private: